@@ -3,80 +3,223 @@
 #include "Player.h"
 #include "TileBag.h"
 #include "Rules.h"
+#include <algorithm>
 
-        void Ai::placeTile(GameBoard* board, Player* player, int x, int y, Tile* tile, int score){
-            // Place the best tile
-            board->placeTile(x, y, tile);
-            // Remove the tile from the player's hand
-            player->removeTileFromHand(tile);
-            player->setScore(player->getScore() + score);
-            std::cout << "\nMR ROBOTO played: " << tile->print() << " at " << char(x + 'A') << y << " for a score of " << score << std::endl;
+std::unique_ptr<ThreadPool> Ai::pool(new ThreadPool(1));
+int Ai::timeBudgetMs = 0;
+
+// Later turns count for less, the opponent plays in between and the tiles drawn to refill
+// a hand are not known, so keeping tiles back is only worth it for clearly better moves
+#define LOOK_AHEAD_WEIGHT 0.5
+
+        void Ai::placeMove(GameBoard* board, Player* player, const Move& move){
+            // Place the best tiles
+            MoveGenerator::applyMove(board, move);
+            player->setScore(player->getScore() + move.score);
+            // Remove the tiles from the player's hand, the board keeps its own copies
+            for (int i = 0; i < move.count; ++i) {
+                player->removeTileFromHand(Tile::fromCode(move.placements[i].tile));
+            }
         }
 
         
-        void Ai::calculateMove(GameBoard* board, Player* player, TileBag* tileBag){
+        bool Ai::takeTurn(Player* player, TileBag* tileBag, GameBoard* board, Move& move){
+            // Compare the hand against every frontier cell's legal tiles before searching for a move
+            if (!Rules::hasLegalMove(board, player)) {
+                swapTiles(player, tileBag, *board, move);
+                return false;
+            }
+
             // Get the player's hand
-            LinkedList* hand = player->getHand();
-            Node *tile = hand->getHead();
-            
-            if (board->isEmpty()) {
-                // Place the first tile in the middle of the board
-                placeTile(board, player, board->getRows() / 2, board->getCols() / 2, tile->getTile(), 1);
-                return;
-            }
-
-            int bestX;
-            int bestY;
-            int bestScore = 0;
-            Node *bestTile;
-                
-            // Loop through the player's hand
-            while (tile != nullptr) {
-                // Loop through the board
-                for (int i = 0; i >= 0 && i < board->getRows(); ++i) {
-                    for (int j = 0; j >= 0 && j < board->getCols(); ++j) {
-                        // Check if the move is valid
-                        if (Rules::validateMove(board, tile->getTile(), i, j)) {
-                            // Place the tile                            
-                            board->placeTile(i, j, tile->getTile());
-
-                            int currentScore = (Rules::calculateScore(board, i, j));
-                            if (currentScore > bestScore) {
-                                bestX = i;
-                                bestY = j;
-                                bestScore = currentScore;
-                                bestTile = tile;
-                            }
-                            board->placeTile(i, j, nullptr);
-                        }
+            std::vector<TileCode> hand;
+            for (Tile tile : *player->getHand()) {
+                hand.push_back(tile.getCode());
+            }
+
+            // Every line of tiles the hand can make, the first move is built through the middle of the board.
+            // hasLegalMove found a tile that fits, so this should always find a move, but a turn never
+            // plays a move that was not filled in.
+            if (!chooseMove(*board, hand, move, timeBudgetMs)) {
+                swapTiles(player, tileBag, *board, move);
+                return false;
+            }
+
+            // Refill the hand for each tile played, a swap already drew its replacement
+            placeMove(board, player, move);
+            player->drawQuantityTiles(tileBag, move.count);
+            return true;
+        };
+
+        bool Ai::chooseMove(const GameBoard& board, const std::vector<TileCode>& hand, Move& bestMove, int timeBudgetMs){
+            Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeBudgetMs);
+
+            if (timeBudgetMs <= 0) {
+                return findBestMove(board, hand, bestMove);
+            }
+
+            // The one turn search always runs to the end, so a move is ready however short the budget
+            std::vector<Move> moves;
+            MoveGenerator::generateMoves(board, hand, moves);
+            if (moves.empty()) {
+                return false;
+            }
+            bestMove = moves.front();
+            for (const Move& move : moves) {
+                if (MoveGenerator::isBetterMove(move, bestMove)) {
+                    bestMove = move;
+                }
+            }
+
+            int tasks = std::min<int>(moves.size(), pool->getWorkers() * 4);
+
+            // Every move places a tile, so a hand can not last more turns than it has tiles
+            for (int turns = 2; turns <= (int)hand.size(); ++turns) {
+                std::vector<double> values(moves.size());
+                std::atomic<bool> timedOut(false);
+
+                // Each worker plays moves out on its own copy of the board
+                pool->run(tasks, [&](int task) {
+                    GameBoard workerBoard(board);
+                    for (size_t i = task; i < moves.size() && !timedOut; i += tasks) {
+                        MoveGenerator::applyMove(&workerBoard, moves[i]);
+                        values[i] = moves[i].score +
+                                    LOOK_AHEAD_WEIGHT * lookAhead(workerBoard, remainingHand(hand, moves[i]), turns - 1, deadline, timedOut);
+                        MoveGenerator::undoMove(&workerBoard, moves[i]);
+                    }
+                });
+
+                // An unfinished search is thrown away, the last finished one stands
+                if (timedOut) {
+                    break;
+                }
+                size_t best = 0;
+                for (size_t i = 1; i < moves.size(); ++i) {
+                    if (values[i] > values[best] || (values[i] == values[best] && MoveGenerator::isBetterMove(moves[i], moves[best]))) {
+                        best = i;
                     }
                 }
-                if (tile->getNext() == nullptr){         
-                    if (bestScore > 0) {          
-                    placeTile(board, player, bestX, bestY, bestTile->getTile(), bestScore);
-                    } else {
-                        // No valid moves, draw a tile
-                        std::cout << "\nMR ROBOTO drew a tile from the tilebag.\n" << std::endl;
-                        Tile* newTile = tileBag->drawTile();
-                        if (newTile != nullptr)
-                        {
-                            player->addTileToHand(newTile);
-                            player->removeTileFromHand(tile->getTile());
-                            tileBag->addTile(tile->getTile());
-                        }
+                bestMove = moves[best];
+            }
+            return true;
+        }
+
+        double Ai::lookAhead(GameBoard& board, const std::vector<TileCode>& hand, int turns,
+                          Clock::time_point deadline, std::atomic<bool>& timedOut){
+            if (turns == 0 || hand.empty() || timedOut) {
+                return 0;
+            }
+            if (Clock::now() >= deadline) {
+                timedOut = true;
+                return 0;
+            }
+            std::vector<Move> moves;
+            MoveGenerator::generateMoves(board, hand, moves);
+            double best = 0;
+            for (const Move& move : moves) {
+                // The last turn's moves already carry their scores, so they need not be played out
+                if (turns == 1 || timedOut) {
+                    best = std::max<double>(best, move.score);
+                    continue;
+                }
+                MoveGenerator::applyMove(&board, move);
+                best = std::max(best, move.score + LOOK_AHEAD_WEIGHT * lookAhead(board, remainingHand(hand, move), turns - 1, deadline, timedOut));
+                MoveGenerator::undoMove(&board, move);
+            }
+            return best;
+        }
+
+        std::vector<TileCode> Ai::remainingHand(const std::vector<TileCode>& hand, const Move& move){
+            std::vector<TileCode> remaining = hand;
+            for (int i = 0; i < move.count; ++i) {
+                remaining.erase(std::find(remaining.begin(), remaining.end(), move.placements[i].tile));
+            }
+            return remaining;
+        }
+
+        bool Ai::findBestMove(const GameBoard& board, const std::vector<TileCode>& hand, Move& bestMove){
+            std::vector<BoardCell> anchors = MoveGenerator::getAnchors(board);
+
+            // Deal the anchors out round robin so busy and quiet parts of the board are shared evenly,
+            // with a few tasks per worker so one slow task does not hold up the rest
+            int tasks = std::min<int>(anchors.size(), pool->getWorkers() * 4);
+            std::vector<Move> taskBest(tasks);
+            std::vector<char> taskFound(tasks, false);
+
+            // Workers only read the board, which stays unchanged until the search is over
+            pool->run(tasks, [&](int task) {
+                std::vector<BoardCell> taskAnchors;
+                for (size_t i = task; i < anchors.size(); i += tasks) {
+                    taskAnchors.push_back(anchors[i]);
+                }
+                std::vector<Move> moves;
+                MoveGenerator::generateMoves(board, hand, taskAnchors, moves);
+                for (const Move& move : moves) {
+                    if (!taskFound[task] || MoveGenerator::isBetterMove(move, taskBest[task])) {
+                        taskBest[task] = move;
+                        taskFound[task] = true;
                     }
                 }
-                tile = tile->getNext();
-            }            
+            });
+
+            // isBetterMove never ties two different moves, so the pick is the same however the work was split
+            bool found = false;
+            for (int task = 0; task < tasks; ++task) {
+                if (taskFound[task] && (!found || MoveGenerator::isBetterMove(taskBest[task], bestMove))) {
+                    bestMove = taskBest[task];
+                    found = true;
+                }
+            }
+            return found;
+        }
+
+        void Ai::setWorkers(int workers){
+            pool.reset(new ThreadPool(std::max(1, workers)));
+        }
+
+        int Ai::getWorkers(){
+            return pool->getWorkers();
+        }
+
+        void Ai::setTimeBudget(int timeBudgetMs){
+            Ai::timeBudgetMs = std::max(0, timeBudgetMs);
+        }
+
+        int Ai::getTimeBudget(){
+            return timeBudgetMs;
+        }
+
+        void Ai::swapTiles(Player* player, TileBag* tileBag, const GameBoard& board, Move& move){
+            // No valid moves, trade the tiles whose replacements are expected to score best
+            Clock::time_point deadline = timeBudgetMs > 0 ? Clock::now() + std::chrono::milliseconds(timeBudgetMs)
+                                                          : Clock::time_point::max();
+            Hand hand = *player->getHand();
+            int swap = SwapEvaluator::chooseSwap(board, hand, player->getUnseenTiles(board), tileBag->getLength(), deadline);
+
+            // The traded tiles are set aside until the new ones are drawn, so none come straight back
+            move.count = 0;
+            move.score = 0;
+            for (int i = 0; i < hand.getLength(); ++i) {
+                if (swap & (1 << i)) {
+                    player->removeTileFromHand(hand.get(i));
+                    move.placements[move.count++] = {-1, -1, hand.get(i).getCode()};
+                }
+            }
+            player->drawQuantityTiles(tileBag, move.count);
+            for (int i = 0; i < move.count; ++i) {
+                tileBag->addTile(Tile::fromCode(move.placements[i].tile));
+            }
         };
         
-        void Ai::playTurn(Player* player, TileBag* tileBag, GameBoard* board){
-
-            calculateMove(board, player, tileBag);
-            
-            Tile* newTile = tileBag->drawTile();
-            if (newTile != nullptr)
-            {
-                player->addTileToHand(newTile);
+        bool Ai::playTurn(Player* player, TileBag* tileBag, GameBoard* board, Move& move){
+            bool placed = takeTurn(player, tileBag, board, move);
+            if (placed) {
+                std::cout << "\nMR ROBOTO played: " << MoveGenerator::describeMove(move) << " for a score of " << move.score << std::endl;
+            } else if (move.count == 0) {
+                std::cout << "\nMR ROBOTO had nothing to play or swap and passed.\n" << std::endl;
+            } else if (move.count == 1) {
+                std::cout << "\nMR ROBOTO drew a tile from the tilebag.\n" << std::endl;
+            } else {
+                std::cout << "\nMR ROBOTO drew " << move.count << " tiles from the tilebag.\n" << std::endl;
             }
+            return placed;
         };
\ No newline at end of file
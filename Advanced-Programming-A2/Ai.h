@@ -1,11 +1,61 @@
+#ifndef ASSIGN2_AI_H
+#define ASSIGN2_AI_H
+
 #include "GameBoard.h"
 #include "Player.h"
 #include "TileBag.h"
+#include "MoveGenerator.h"
+#include "SwapEvaluator.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
 
 class Ai {
     public:
-        static void playTurn(Player *player, TileBag *tileBag, GameBoard *board);
+        // Take a turn as takeTurn does and print what the AI did
+        static bool playTurn(Player *player, TileBag *tileBag, GameBoard *board, Move& move);
+
+        // Play the best move, or swap tiles when no tile fits, without printing anything.
+        // Returns false after a swap, with the traded tiles in the move and no score. A swap of no
+        // tiles is a pass, which only happens when the bag is empty or the hand is.
+        // Otherwise fills in the move that was played.
+        static bool takeTurn(Player* player, TileBag* tileBag, GameBoard* board, Move& move);
+
+        // Find the best move for a hand without changing the board, false if there is none.
+        // Without a time budget this is the highest scoring move. With one, the search deepens a
+        // turn at a time, adding the best follow up moves the rest of the hand could make, and
+        // returns the move from the deepest search finished within the budget. The search is
+        // shared between the workers, the chosen move never depends on how many.
+        static bool chooseMove(const GameBoard& board, const std::vector<TileCode>& hand, Move& bestMove, int timeBudgetMs = 0);
+
+        // Number of threads searching for moves, one searches on the calling thread only
+        static void setWorkers(int workers);
+        static int getWorkers();
+
+        // Milliseconds playTurn may spend choosing a move, zero plays the highest scoring move
+        static void setTimeBudget(int timeBudgetMs);
+        static int getTimeBudget();
     private:
-        static void calculateMove(GameBoard* board, Player* player, TileBag* tileBag);
-        static void placeTile(GameBoard* board, Player* player, int x, int y, Tile* tile, int score);
-};
\ No newline at end of file
+        typedef std::chrono::steady_clock Clock;
+
+        static std::unique_ptr<ThreadPool> pool;
+        static int timeBudgetMs;
+
+        // Highest scoring move for a hand, searched across the workers
+        static bool findBestMove(const GameBoard& board, const std::vector<TileCode>& hand, Move& bestMove);
+
+        // Most points the hand can add over the given number of turns if the board is left alone,
+        // each turn weighted less than the one before, setting timedOut once the deadline has passed
+        static double lookAhead(GameBoard& board, const std::vector<TileCode>& hand, int turns,
+                             Clock::time_point deadline, std::atomic<bool>& timedOut);
+
+        // Hand left once a move's tiles are played
+        static std::vector<TileCode> remainingHand(const std::vector<TileCode>& hand, const Move& move);
+
+        static void placeMove(GameBoard* board, Player* player, const Move& move);
+        // Trade the tiles SwapEvaluator rates best back into the bag, recording them in move
+        static void swapTiles(Player* player, TileBag* tileBag, const GameBoard& board, Move& move);
+};
+
+#endif // ASSIGN2_AI_H
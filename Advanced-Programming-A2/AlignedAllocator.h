@@ -0,0 +1,53 @@
+#ifndef ASSIGN2_ALIGNEDALLOCATOR_H
+#define ASSIGN2_ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#define CACHE_LINE_SIZE 64
+
+/*
+ * Minimal allocator that hands std::vector storage starting on an
+ * Alignment byte boundary, so small hot arrays (such as the board grid)
+ * begin on a fresh cache line.
+ */
+template <typename T, std::size_t Alignment = CACHE_LINE_SIZE>
+class AlignedAllocator {
+public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() {}
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t count) {
+        void* memory = nullptr;
+        if (posix_memalign(&memory, Alignment, count * sizeof(T)) != 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* memory, std::size_t) {
+        std::free(memory);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const {
+        return false;
+    }
+};
+
+#endif // ASSIGN2_ALIGNEDALLOCATOR_H
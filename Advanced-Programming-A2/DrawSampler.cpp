@@ -0,0 +1,125 @@
+#include "DrawSampler.h"
+#include "TileBag.h"
+#include "UnseenTiles.h"
+
+DrawSampler::DrawSampler(const TileBag& bag, std::uint64_t seed) : counts(), total(0), random(seed) {
+    for (int i = 0; i < bag.getLength(); ++i) {
+        int index = Tile::tileIndex(bag.get(i).getCode());
+        if (index >= 0) {
+            counts[index]++;
+            total++;
+        }
+    }
+    rebuild();
+}
+
+DrawSampler::DrawSampler(const UnseenTiles& unseen, std::uint64_t seed) : counts(), total(0), random(seed) {
+    for (TileMask remaining = unseen.getMask(); remaining != 0; remaining &= remaining - 1) {
+        int index = __builtin_ctzll(remaining);
+        counts[index] = unseen.count(Tile::fromCode(Tile::indexCode(index)));
+        total += counts[index];
+    }
+    rebuild();
+}
+
+Tile DrawSampler::draw() {
+    Tile tile = sample();
+    remove(tile);
+    return tile;
+}
+
+Tile DrawSampler::sample() {
+    if (total == 0) {
+        return Tile();
+    }
+    if (total * 2 < weightTotal) {
+        rebuild();
+    }
+    while (true) {
+        // Pick a column, then either its own kind or its alias
+        std::uint64_t bits = random.next();
+        int column = (int)(((bits >> 32) * tableSize) >> 32);
+        int kind = (std::uint32_t)bits < thresholds[column] ? kinds[column] : aliases[column];
+
+        // Keep the pick in proportion to the copies left since the table was built
+        if (counts[kind] == weights[kind] || (int)random.below(weights[kind]) < counts[kind]) {
+            return Tile::fromCode(Tile::indexCode(kind));
+        }
+    }
+}
+
+void DrawSampler::remove(Tile tile) {
+    int index = Tile::tileIndex(tile.getCode());
+    if (index >= 0 && counts[index] > 0) {
+        counts[index]--;
+        total--;
+    }
+}
+
+void DrawSampler::add(Tile tile) {
+    int index = Tile::tileIndex(tile.getCode());
+    if (index < 0) {
+        return;
+    }
+    counts[index]++;
+    total++;
+    // The table can only thin out a kind, one with more copies than it was built with needs a new table
+    if (counts[index] > weights[index]) {
+        rebuild();
+    }
+}
+
+int DrawSampler::count(Tile tile) const {
+    int index = Tile::tileIndex(tile.getCode());
+    return index < 0 ? 0 : counts[index];
+}
+
+void DrawSampler::rebuild() {
+    // Vose's method, every column holds at most two kinds and their shares add up to one
+    tableSize = 0;
+    weightTotal = total;
+    double share[TILE_MASK_BITS];
+    for (int kind = 0; kind < TILE_MASK_BITS; ++kind) {
+        weights[kind] = counts[kind];
+        if (counts[kind] > 0) {
+            kinds[tableSize] = kind;
+            aliases[tableSize] = kind;
+            tableSize++;
+        }
+    }
+    if (tableSize == 0) {
+        return;
+    }
+
+    int small[TILE_MASK_BITS];
+    int large[TILE_MASK_BITS];
+    int smallCount = 0;
+    int largeCount = 0;
+    for (int column = 0; column < tableSize; ++column) {
+        share[column] = (double)counts[kinds[column]] * tableSize / total;
+        if (share[column] < 1) {
+            small[smallCount++] = column;
+        } else {
+            large[largeCount++] = column;
+        }
+    }
+    while (smallCount > 0 && largeCount > 0) {
+        int less = small[--smallCount];
+        int more = large[--largeCount];
+        thresholds[less] = (std::uint32_t)(share[less] * 4294967296.0);
+        aliases[less] = kinds[more];
+        share[more] -= 1 - share[less];
+        if (share[more] < 1) {
+            small[smallCount++] = more;
+        } else {
+            large[largeCount++] = more;
+        }
+    }
+    // Whatever is left is full up to rounding, it always keeps its own kind
+    while (largeCount > 0) {
+        thresholds[large[--largeCount]] = UINT32_MAX;
+    }
+    while (smallCount > 0) {
+        thresholds[small[--smallCount]] = UINT32_MAX;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef ASSIGN2_DRAWSAMPLER_H
+#define ASSIGN2_DRAWSAMPLER_H
+
+#include <cstdint>
+#include <type_traits>
+#include "Random.h"
+#include "Tile.h"
+
+class TileBag;
+class UnseenTiles;
+
+/*
+ * Draws made up tiles in proportion to how many copies of each are left,
+ * without touching the real bag or its order. A Walker alias table picks a
+ * tile kind in constant time from the counts the table was built with, and a
+ * pick is kept in proportion to the copies still left, so taking tiles out is
+ * a single decrement. The table is rebuilt once half of it has been drawn, so
+ * the rejected picks never cost more than a couple of tries per draw.
+ */
+class DrawSampler {
+public:
+    // Tiles as they are in the bag, or every tile a player can not see
+    DrawSampler(const TileBag& bag, std::uint64_t seed);
+    DrawSampler(const UnseenTiles& unseen, std::uint64_t seed);
+
+    // Draw a tile and take it out of the counts, the empty tile when none are left
+    Tile draw();
+    // Pick a tile and leave it in
+    Tile sample();
+
+    // Take out or put back one copy of a tile, such as one seen drawn in the real game
+    void remove(Tile tile);
+    void add(Tile tile);
+
+    // Start the sampler's generator again, so copies of one sampler can draw differently
+    void reseed(std::uint64_t seed) { random.setState(seed); }
+
+    int count(Tile tile) const;
+    int getTotal() const { return total; }
+    bool isEmpty() const { return total == 0; }
+
+private:
+    // Copies left of each tile, indexed by Tile::tileIndex
+    unsigned char counts[TILE_MASK_BITS];
+    int total;
+
+    // Alias table over the tile kinds, built from the counts in weights
+    unsigned char weights[TILE_MASK_BITS];
+    int weightTotal;
+    unsigned char kinds[TILE_MASK_BITS];
+    unsigned char aliases[TILE_MASK_BITS];
+    std::uint32_t thresholds[TILE_MASK_BITS];
+    int tableSize;
+
+    Random random;
+
+    void rebuild();
+};
+
+static_assert(std::is_trivially_copyable<DrawSampler>::value, "Samplers are copied as plain bytes for each rollout");
+
+#endif // ASSIGN2_DRAWSAMPLER_H
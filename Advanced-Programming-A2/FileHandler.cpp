@@ -1,137 +1,82 @@
 #include "FileHandler.h"
+#include "MappedFile.h"
+#include "MoveJournal.h"
+#include "SaveFormat.h"
+#include "SaveParser.h"
+#include "TileCodes.h"
+#include "TileSet.h"
+#include "SaveWriter.h"
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <vector>
 
-/*
- * Helper function to convert LinkedList to std::vector
- * This function iterates through the linked list, extracts each tile,
- * and adds it to a std::vector.
- */
-std::vector<Tile*> FileHandler::linkedListToVector(LinkedList* list) {
-    std::vector<Tile*> vec;
-    Node* current = list->getHead();
-    while (current) {
-        vec.push_back(current->getTile());
-        current = current->getNext();
-    }
-    return vec;
-}
-
-/*
- * Helper function to convert std::vector to LinkedList
- * This function iterates through the std::vector,
- * and adds each tile to the linked list.
- */
-void FileHandler::vectorToLinkedList(const std::vector<Tile*>& vec, LinkedList* list) {
-    list->clear();
-    for (Tile* tile : vec) {
-        list->addBack(tile);
-    }
-}
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 /*
  * Save the game state to a file
- * This function serializes the players, board, tile bag,
- * and current player, then writes them to a file.
+ * This function takes a snapshot of the players, board, tile bag,
+ * and current player, then writes it out before returning.
  */
 void FileHandler::saveGame(const std::string& filename, Player* player1, Player* player2, TileBag* tileBag, GameBoard* board, Player* currentPlayer, bool aiMode) {
-    std::ofstream outFile(filename);
-    if (outFile.is_open()) {
-        outFile << serialisePlayer(player1) << std::endl;
-        outFile << serialisePlayer(player2) << std::endl;
-        outFile << serialiseBoard(board) << std::endl;
-        outFile << serialiseTileBag(tileBag) << std::endl;
-        outFile << serialiseCurrentPlayer(currentPlayer) << std::endl;
-        outFile << (aiMode ? "AI" : "STD");
-        outFile.close();
+    SaveSnapshot snapshot(filename, player1, player2, tileBag, board, currentPlayer, aiMode);
+    std::string error;
+    if (writeSnapshot(snapshot, error)) {
         std::cout << "Game successfully saved" << std::endl;
     } else {
-        std::cerr << "Error: Unable to open file for writing" << std::endl;
+        std::cerr << "Error: " << error << std::endl;
     }
 }
 
 /*
- * Load the game state from a file
- * This function reads the serialized players, board, tile bag,
- * and current player from a file and deserializes them.
- * THE BELOW INCLUDES PRINT OUTS TO CHECK FILE IS READING
- * CORRECTLY AND MAY BE DELETED AND THE ABOVE FUNCTION USED
- * INSTEAD.
+ * Write a snapshot to its file, in the format its file name asks for
+ * The whole save is built in memory and written to a temporary file
+ * beside the save, which then replaces it. A save that fails part way
+ * leaves the old file as it was.
  */
-bool FileHandler::loadGame(const std::string& filename, Player* player1, Player* player2, TileBag* tileBag, GameBoard*& board, Player* currentPlayer, bool &aiMode) {
-    std::ifstream inFile(filename);
-    if (inFile.is_open()) {
-        std::string player1Data, player2Data, boardData, tileBagData, currentPlayerData, gameMode;
-
-        // Read and deserialize Player 1
-        std::getline(inFile, player1Data);
-        std::string player1Score;
-        std::getline(inFile, player1Score);
-        player1Data += "\n" + player1Score;
-
-        std::string player1Hand;
-        std::getline(inFile, player1Hand);
-        player1Data += "\n" + player1Hand;
-
-        // std::cout << "Player 1 Data: " << player1Data << std::endl;
-        deserialisePlayer(player1, player1Data);
-
-        // Read and deserialize Player 2
-        std::getline(inFile, player2Data);
-        std::string player2Score;
-        std::getline(inFile, player2Score);
-        player2Data += "\n" + player2Score;
-
-        std::string player2Hand;
-        std::getline(inFile, player2Hand);
-        player2Data += "\n" + player2Hand;
-
-        // std::cout << "Player 2 Data: " << player2Data << std::endl;
-        deserialisePlayer(player2, player2Data);
-
-        // Read and deserialize Board
-        std::getline(inFile, boardData);
-        std::string boardTiles;
-        std::getline(inFile, boardTiles);
-        boardData += "\n" + boardTiles;
-
-         // Create a new GameBoard with the deserialized data
-        GameBoard* newBoard = deserialiseBoard(boardData);
-        if (newBoard) {
-          if (board) {
-            newBoard->setEnhancedMode(board->getEnhancedMode());
-            // Clean up the old board if it exists
-            delete board;
-            // Set to nullptr after deletion to avoid dangling pointer
-            board = nullptr;  
-          }
-          board = newBoard;
-        } else {
-          std::cerr << "Error: Invalid board data" << std::endl;
-          inFile.close();
-          return false;
+bool FileHandler::writeSnapshot(const SaveSnapshot& snapshot, std::string& error) {
+    std::string data;
+    if (isBinarySave(snapshot.filename)) {
+        if (!serialiseBinaryGame(snapshot, data, error)) {
+            return false;
         }
+    } else if (!serialiseTextGame(snapshot, data, error)) {
+        return false;
+    }
+    return replaceFile(snapshot.filename, data, error);
+}
 
-        // Read and deserialize Tile Bag
-        std::getline(inFile, tileBagData);
-        // std::cout << "Tile Bag Data: " << tileBagData << std::endl;
-        deserialiseTileBag(tileBag, tileBagData);
-
-        // Read and deserialize Current Player
-        std::getline(inFile, currentPlayerData);
-        // std::cout << "Current Player Data: " << currentPlayerData << std::endl;
-        deserialiseCurrentPlayer(currentPlayer, currentPlayerData);
-        
-        std::getline(inFile, gameMode);
-        deserialiseGameMode(aiMode, gameMode);
-
-        inFile.close();
-        return true;
-    } else {
+/*
+ * Load the game state from a file
+ * The file is read in place by a SaveParser and nothing in the game is
+ * changed unless the whole file is valid. Saves from before the game mode
+ * and random state lines were added still load.
+ */
+bool FileHandler::loadGame(const std::string& filename, Player* player1, Player* player2, TileBag* tileBag, GameBoard*& board, Player* currentPlayer, bool &aiMode, bool applyJournal) {
+    if (isBinarySave(filename)) {
+        return loadBinaryGame(filename, player1, player2, tileBag, board, currentPlayer, aiMode, applyJournal);
+    }
+    MappedFile file;
+    if (!file.open(filename)) {
         std::cerr << "Error: Unable to open file for reading" << std::endl;
         return false;
     }
+    SaveParser parser(reinterpret_cast<const char*>(file.getData()), file.getSize());
+    if (!parseTextGame(parser, player1, player2, tileBag, board, currentPlayer, aiMode)) {
+        const SaveParseError& error = parser.getError();
+        std::cerr << "Error: " << filename << ":" << error.line << ":" << error.column << ": " << error.message << std::endl;
+        return false;
+    }
+    if (applyJournal) {
+        replayJournal(filename, file.getData(), file.getSize(), player1, player2, tileBag, board, currentPlayer);
+    }
+    return true;
 }
 
 /*
@@ -143,6 +88,202 @@ bool FileHandler::fileExists(const std::string& filename) {
     return file.good();
 }
 
+bool FileHandler::isBinarySave(const std::string& filename) {
+    std::size_t extension = std::strlen(BINARY_SAVE_EXTENSION);
+    return filename.size() > extension &&
+           filename.compare(filename.size() - extension, extension, BINARY_SAVE_EXTENSION) == 0;
+}
+
+/*
+ * Save the game state in the binary format
+ * The header is filled in first, then the names and tiles are packed
+ * after it so the whole buffer can be written in one go.
+ */
+bool FileHandler::serialiseBinaryGame(const SaveSnapshot& snapshot, std::string& data, std::string& error) {
+    if (snapshot.rows > 255 || snapshot.cols > 255 || snapshot.names[0].size() > 255 || snapshot.names[1].size() > 255) {
+        error = "Game is too large for a binary save";
+        return false;
+    }
+
+    SaveHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SAVE_MAGIC, SAVE_MAGIC_LENGTH);
+    header.version = SAVE_VERSION;
+    header.headerSize = sizeof(SaveHeader);
+    header.colours = TileSet::getColours();
+    header.shapes = TileSet::getShapes();
+    header.copies = TileSet::getCopies();
+    header.flags = (snapshot.aiMode ? SAVE_AI_MODE : 0) | (snapshot.secondToMove ? SAVE_SECOND_PLAYER_TO_MOVE : 0);
+    header.rows = snapshot.rows;
+    header.cols = snapshot.cols;
+    header.boardTiles = snapshot.boardTiles.size();
+    header.bagTiles = snapshot.tileBag.getLength();
+    header.seed = snapshot.tileBag.getSeed();
+    header.randomState = snapshot.tileBag.getRandomState();
+
+    data.assign(sizeof(SaveHeader), '\0');
+    data.reserve(sizeof(SaveHeader) + 2 * (255 + MAX_HAND_SIZE) + SAVE_BOARD_RECORD_SIZE * header.boardTiles + header.bagTiles);
+    for (int i = 0; i < 2; ++i) {
+        header.nameLengths[i] = snapshot.names[i].size();
+        data += snapshot.names[i];
+    }
+    for (int i = 0; i < 2; ++i) {
+        header.handLengths[i] = snapshot.hands[i].getLength();
+        header.scores[i] = snapshot.scores[i];
+        for (Tile tile : snapshot.hands[i]) {
+            data.push_back(tile.getCode());
+        }
+    }
+    for (const SavedTile& tile : snapshot.boardTiles) {
+        data.push_back(tile.code);
+        data.push_back(tile.row);
+        data.push_back(tile.col);
+    }
+    for (int i = 0; i < snapshot.tileBag.getLength(); ++i) {
+        data.push_back(snapshot.tileBag.get(i).getCode());
+    }
+
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(&data[0]);
+    std::memcpy(bytes, &header, sizeof(header));
+    header.checksum = saveChecksum(bytes, data.size());
+    std::memcpy(bytes + offsetof(SaveHeader, checksum), &header.checksum, sizeof(header.checksum));
+    return true;
+}
+
+/*
+ * Load the game state from a binary save
+ * The file is mapped and read where it lies. Everything is checked
+ * before any of the game is changed, so a bad file leaves it as it was.
+ */
+bool FileHandler::loadBinaryGame(const std::string& filename, Player* player1, Player* player2, TileBag* tileBag, GameBoard*& board, Player* currentPlayer, bool &aiMode, bool applyJournal) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cerr << "Error: Unable to open file for reading" << std::endl;
+        return false;
+    }
+    const unsigned char* data = file.getData();
+    std::size_t size = file.getSize();
+
+    SaveHeader header;
+    if (size < sizeof(SaveHeader)) {
+        std::cerr << "Error: Save file is too short" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, SAVE_MAGIC, SAVE_MAGIC_LENGTH) != 0) {
+        std::cerr << "Error: Not a binary save file" << std::endl;
+        return false;
+    }
+    if (header.version != SAVE_VERSION || header.headerSize < sizeof(SaveHeader)) {
+        std::cerr << "Error: Unsupported save version " << header.version << std::endl;
+        return false;
+    }
+
+    std::size_t expected = header.headerSize + header.nameLengths[0] + header.nameLengths[1] + header.handLengths[0] +
+                           header.handLengths[1] + SAVE_BOARD_RECORD_SIZE * header.boardTiles + header.bagTiles;
+    const std::uint64_t noChecksum = 0;
+    std::uint64_t checksum = saveChecksum(data, offsetof(SaveHeader, checksum));
+    checksum = saveChecksum(reinterpret_cast<const unsigned char*>(&noChecksum), sizeof(noChecksum), checksum);
+    checksum = saveChecksum(data + sizeof(SaveHeader), size - sizeof(SaveHeader), checksum);
+    if (size != expected || checksum != header.checksum) {
+        std::cerr << "Error: Save file is damaged" << std::endl;
+        return false;
+    }
+
+    // The tile set has to be known before the tiles can be checked against it
+    int previousColours = TileSet::getColours();
+    int previousShapes = TileSet::getShapes();
+    int previousCopies = TileSet::getCopies();
+    if (!TileSet::configure(header.colours, header.shapes, header.copies)) {
+        std::cerr << "Error: Save file has an invalid tile set" << std::endl;
+        return false;
+    }
+
+    const unsigned char* names = data + header.headerSize;
+    const unsigned char* hands = names + header.nameLengths[0] + header.nameLengths[1];
+    const unsigned char* boardTiles = hands + header.handLengths[0] + header.handLengths[1];
+    const unsigned char* bagTiles = boardTiles + SAVE_BOARD_RECORD_SIZE * header.boardTiles;
+
+    bool valid = header.handLengths[0] <= MAX_HAND_SIZE && header.handLengths[1] <= MAX_HAND_SIZE &&
+                 header.bagTiles <= MAX_BAG_TILES && header.rows > 0 && header.cols > 0;
+    for (const unsigned char* code = hands; code < boardTiles; ++code) {
+        valid = valid && TileSet::contains(Tile::fromCode(*code));
+    }
+    for (const unsigned char* record = boardTiles; record < bagTiles; record += SAVE_BOARD_RECORD_SIZE) {
+        valid = valid && TileSet::contains(Tile::fromCode(record[0])) && record[1] < header.rows && record[2] < header.cols;
+    }
+    for (const unsigned char* code = bagTiles; code < data + size; ++code) {
+        valid = valid && TileSet::contains(Tile::fromCode(*code));
+    }
+    if (!valid) {
+        TileSet::configure(previousColours, previousShapes, previousCopies);
+        std::cerr << "Error: Save file holds tiles that are not in the game" << std::endl;
+        return false;
+    }
+
+    // Like a text save, a binary save may only place one tile on each cell
+    std::vector<bool> occupied(header.rows * header.cols, false);
+    for (const unsigned char* record = boardTiles; valid && record < bagTiles; record += SAVE_BOARD_RECORD_SIZE) {
+        int cell = record[1] * header.cols + record[2];
+        valid = !occupied[cell];
+        occupied[cell] = true;
+    }
+    if (!valid) {
+        TileSet::configure(previousColours, previousShapes, previousCopies);
+        std::cerr << "Error: Save file has more than one tile on a cell" << std::endl;
+        return false;
+    }
+
+    Player* players[2] = {player1, player2};
+    const unsigned char* name = names;
+    const unsigned char* hand = hands;
+    for (int i = 0; i < 2; ++i) {
+        players[i]->setName(std::string(reinterpret_cast<const char*>(name), header.nameLengths[i]));
+        players[i]->setScore(header.scores[i]);
+        players[i]->getHand()->clear();
+        for (int tile = 0; tile < header.handLengths[i]; ++tile) {
+            players[i]->addTileToHand(Tile::fromCode(hand[tile]));
+        }
+        name += header.nameLengths[i];
+        hand += header.handLengths[i];
+    }
+
+    GameBoard* newBoard = new GameBoard(header.rows, header.cols);
+    for (const unsigned char* record = boardTiles; record < bagTiles; record += SAVE_BOARD_RECORD_SIZE) {
+        newBoard->placeTile(record[1], record[2], Tile::fromCode(record[0]));
+    }
+    if (board) {
+        newBoard->setEnhancedMode(board->getEnhancedMode());
+        delete board;
+    }
+    board = newBoard;
+
+    tileBag->clear();
+    for (const unsigned char* code = bagTiles; code < data + size; ++code) {
+        tileBag->addTile(Tile::fromCode(*code));
+    }
+    tileBag->setRandomState(header.seed, header.randomState);
+
+    currentPlayer->setName(players[(header.flags & SAVE_SECOND_PLAYER_TO_MOVE) ? 1 : 0]->getName());
+    aiMode = (header.flags & SAVE_AI_MODE) != 0;
+    if (applyJournal) {
+        replayJournal(filename, data, size, player1, player2, tileBag, board, currentPlayer);
+    }
+    return true;
+}
+
+/*
+ * Replay the turns played since a save was written, if it has a journal
+ * The journal only counts if it was started for exactly these save bytes.
+ */
+void FileHandler::replayJournal(const std::string& filename, const unsigned char* data, std::size_t size, Player* player1, Player* player2, TileBag* tileBag, GameBoard* board, Player* currentPlayer) {
+    int turns = MoveJournal::replay(filename, saveChecksum(data, size), player1, player2, tileBag, board, currentPlayer);
+    if (turns > 0) {
+        std::cout << "Recovered " << turns << (turns == 1 ? " turn" : " turns") << " from "
+                  << MoveJournal::journalFile(filename) << std::endl;
+    }
+}
+
 /*
  * Method to read file content into a string.
  */
@@ -175,240 +316,206 @@ std::string FileHandler::readFileContent(const std::string& filename) const {
 
 
 /*
- * Serialize a Player object to a string
- * This function converts the player's name, score, and hand
- * to a string representation.
+ * Serialize a snapshot to the text save format
+ * Each player's name, score and hand come first, then the board size
+ * and tiles, the tile bag, the current player, the game mode and the
+ * bag's random state, one to a line. Rows are written as letters,
+ * so a board with more rows than letters only fits in a binary save.
  */
-std::string FileHandler::serialisePlayer(Player* player) {
-    std::string result;
-    result += player->getName() + "\n";
-    result += std::to_string(player->getScore()) + "\n";
-
-    LinkedList* hand = player->getHand();
-    Node* current = hand->getHead();
-    while (current) {
-        Tile* tile = current->getTile();
-        result += tile->getColour() + std::to_string(tile->getShape());
-        if (current->getNext()) {
-            result += ",";
+bool FileHandler::serialiseTextGame(const SaveSnapshot& snapshot, std::string& result, std::string& error) {
+    if (snapshot.rows > MAX_TEXT_SAVE_ROWS) {
+        error = "A board of " + std::to_string(snapshot.rows) + " rows is too tall for a text save, use a " +
+                BINARY_SAVE_EXTENSION + " file";
+        return false;
+    }
+    result.clear();
+    for (int i = 0; i < 2; ++i) {
+        result += snapshot.names[i] + "\n";
+        result += std::to_string(snapshot.scores[i]) + "\n";
+        bool first = true;
+        for (Tile tile : snapshot.hands[i]) {
+            serialiseTile(result, tile, first);
         }
-        current = current->getNext();
+        result += "\n";
     }
 
-    return result;
-}
+    result += std::to_string(snapshot.rows) + "," + std::to_string(snapshot.cols) + "\n";
+    bool first = true;
+    for (const SavedTile& tile : snapshot.boardTiles) {
+        serialiseTile(result, Tile::fromCode(tile.code), first);
+        result += "@" + std::string(1, 'A' + tile.row) + std::to_string(tile.col);
+    }
+    result += "\n";
 
-/*
- * Serialize a TileBag object to a string
- * This function converts the tiles in the bag to a string representation.
- */
-std::string FileHandler::serialiseTileBag(TileBag* tileBag) {
-    std::string result;
-    LinkedList* tiles = tileBag->getTiles();
-    Node* current = tiles->getHead();
-    while (current) {
-        Tile* tile = current->getTile();
-        result += tile->getColour() + std::to_string(tile->getShape());
-        if (current->getNext()) {
-            result += ",";
-        }
-        current = current->getNext();
+    first = true;
+    for (int i = 0; i < snapshot.tileBag.getLength(); ++i) {
+        serialiseTile(result, snapshot.tileBag.get(i), first);
     }
+    result += "\n";
 
-    return result;
+    result += snapshot.names[snapshot.secondToMove ? 1 : 0] + "\n";
+    result += snapshot.aiMode ? "AI\n" : "STD\n";
+    result += std::to_string(snapshot.tileBag.getSeed()) + "," + std::to_string(snapshot.tileBag.getRandomState());
+    return true;
 }
 
 /*
- * Serialize a GameBoard object to a string
- * This function converts the board size and tiles
- * to a string representation.
+ * Serialize one tile of a comma separated list
+ * The comma is left off before the first tile of the list.
  */
-std::string FileHandler::serialiseBoard(GameBoard* board) {
-    std::string result;
-    result += std::to_string(board->getRows()) + "," + std::to_string(board->getCols()) + "\n";
-
-    bool firstTile = true;
-    for (int row = 0; row < board->getRows(); ++row) {
-        for (int col = 0; col < board->getCols(); ++col) {
-            Tile* tile = board->getTile(row, col);
-            if (tile) {
-                if (!firstTile) {
-                    result += ",";
-                }
-                result += tile->getColour() + std::to_string(tile->getShape()) + "@" + std::string(1, 'A' + row) + std::to_string(col);
-                firstTile = false;
-            }
-        }
+void FileHandler::serialiseTile(std::string& result, Tile tile, bool& first) {
+    if (!first) {
+        result += ",";
     }
-
-    return result;
+    result += tile.getColour() + std::to_string(tile.getShape());
+    first = false;
 }
 
-
 /*
- * Serialize the current player to a string
- * This function returns the name of the current player.
+ * Replace a file with new contents
+ * The contents go to a temporary file beside it first, which is flushed
+ * to disk and then renamed over the file in one step, so the file always
+ * holds either the whole of the old save or the whole of the new one.
  */
-std::string FileHandler::serialiseCurrentPlayer(Player* currentPlayer) {
-    return currentPlayer->getName();
+bool FileHandler::replaceFile(const std::string& filename, const std::string& data, std::string& error) {
+    std::string tempName = filename + SAVE_TEMP_EXTENSION;
+#if defined(_WIN32)
+    std::ofstream outFile(tempName, std::ios::binary);
+    if (!outFile.is_open()) {
+        error = "Unable to open file for writing";
+        return false;
+    }
+    outFile.write(data.data(), data.size());
+    outFile.close();
+    bool written = !outFile.fail();
+    bool renamed = written && MoveFileExA(tempName.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+    int fd = ::open(tempName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        error = "Unable to open file for writing";
+        return false;
+    }
+    std::size_t total = 0;
+    bool written = true;
+    while (written && total < data.size()) {
+        ssize_t count = ::write(fd, data.data() + total, data.size() - total);
+        written = count > 0;
+        total += written ? count : 0;
+    }
+    written = ::fsync(fd) == 0 && written;
+    written = ::close(fd) == 0 && written;
+    bool renamed = written && std::rename(tempName.c_str(), filename.c_str()) == 0;
+#endif
+    if (!renamed) {
+        std::remove(tempName.c_str());
+        error = written ? "Unable to replace " + filename : "Unable to write save file";
+        return false;
+    }
+    return true;
 }
 
 /*
- * Deserialize a Player object from a string
- * This function extracts the player's name, score, and hand
- * from a string representation.
+ * Parse a text save, line by line in the order saveGame writes it
+ * The players, board and bag are built up in local copies and only
+ * handed over once the last line has been read.
  */
-void FileHandler::deserialisePlayer(Player* player, const std::string& data) {
-    size_t pos = 0;
-    size_t nextPos = data.find('\n', pos);
-    std::string name = data.substr(pos, nextPos - pos);
-    player->setName(name);
-
-    pos = nextPos + 1;
-    nextPos = data.find('\n', pos);
-    int score = std::stoi(data.substr(pos, nextPos - pos));
-    player->setScore(score);
-
-    pos = nextPos + 1;
-    std::string handData = data.substr(pos);
-    std::vector<Tile*> hand;
-    size_t start = 0;
-    size_t end = handData.find(',', start);
-    while (end != std::string::npos) {
-        std::string tileData = handData.substr(start, end - start);
-        Colour colour = tileData[0];
-        Shape shape = std::stoi(tileData.substr(1));
-        hand.push_back(new Tile(colour, shape));
-
-        start = end + 1;
-        end = handData.find(',', start);
-    }
-    if (start < handData.length()) { // Last tile
-        std::string tileData = handData.substr(start);
-        Colour colour = tileData[0];
-        Shape shape = std::stoi(tileData.substr(1));
-        hand.push_back(new Tile(colour, shape));
-    }
-    vectorToLinkedList(hand, player->getHand());
-}
+bool FileHandler::parseTextGame(SaveParser& parser, Player* player1, Player* player2, TileBag* tileBag, GameBoard*& board, Player* currentPlayer, bool &aiMode) {
+    TextView names[2];
+    int scores[2];
+    Hand hands[2];
+    for (int i = 0; i < 2; ++i) {
+        Hand& hand = hands[i];
+        if (!parser.readLine(names[i]) || !parser.readNumber(scores[i]) ||
+            !parser.readTiles([&](Tile tile) { return hand.add(tile); })) {
+            return false;
+        }
+    }
 
+    std::uint64_t rows = 0;
+    std::uint64_t cols = 0;
+    if (!parser.readPair(rows, cols)) {
+        return false;
+    }
+    if (rows < 1 || rows > 255 || cols < 1 || cols > 255) {
+        return parser.fail("Board size must be from 1 to 255");
+    }
+    GameBoard loadedBoard(rows, cols);
+    bool placed = parser.readPlacedTiles([&](Tile tile, int row, int col) {
+        if (row >= loadedBoard.getRows() || col >= loadedBoard.getCols()) {
+            return parser.fail("Tile " + tile.print() + " is off the board");
+        }
+        if (loadedBoard.getTileCode(row, col) != EMPTY_TILE) {
+            return parser.fail("Tile " + tile.print() + " is on a cell that already has a tile");
+        }
+        loadedBoard.placeTile(row, col, tile);
+        return true;
+    });
+    if (!placed) {
+        return false;
+    }
 
-/*
- * Deserialize a TileBag object from a string
- * This function extracts the tiles from a string representation
- * and adds them to the tile bag.
- */
-void FileHandler::deserialiseTileBag(TileBag* tileBag, const std::string& data) {
-    std::vector<Tile*> tiles;
-    size_t start = 0;
-    size_t end = data.find(',', start);
-    while (end != std::string::npos) {
-        std::string tileEntry = data.substr(start, end - start);
-        Colour colour = tileEntry[0];
-        Shape shape = std::stoi(tileEntry.substr(1));
-        tiles.push_back(new Tile(colour, shape));
-        start = end + 1;
-        end = data.find(',', start);
-    }
-    if (start < data.length()) { // Last tile
-        std::string tileEntry = data.substr(start);
-        Colour colour = tileEntry[0];
-        Shape shape = std::stoi(tileEntry.substr(1));
-        tiles.push_back(new Tile(colour, shape));
-    }
-    vectorToLinkedList(tiles, tileBag->getTiles());
-}
+    // Keeps the bag's own generator for saves without a random state line
+    TileBag loadedBag = *tileBag;
+    loadedBag.clear();
+    bool bagRead = parser.readTiles([&](Tile tile) {
+        if (loadedBag.getLength() == MAX_BAG_TILES) {
+            return false;
+        }
+        loadedBag.addTile(tile);
+        return true;
+    });
+    if (!bagRead) {
+        return false;
+    }
 
-/*
- * Deserialize a GameBoard object from a string
- * This function extracts the board size and tiles
- * from a string representation and sets up the board.
- */
-GameBoard* FileHandler::deserialiseBoard(const std::string& data) {
-  size_t pos = 0;
-  size_t nextPos = data.find('\n', pos);
-  std::string sizeData = data.substr(pos, nextPos - pos);
-  size_t commaPos = sizeData.find(',');
-  if (commaPos == std::string::npos) {
-    std::cerr << "Error: Invalid board size format" << std::endl;
-    return nullptr;
-  }
-
-  int rows = std::stoi(sizeData.substr(0, commaPos));
-  int cols = std::stoi(sizeData.substr(commaPos + 1));
-
-  // Create a new GameBoard with the specified size
-  GameBoard* board = new GameBoard(rows, cols);
-
-  pos = nextPos + 1;
-  std::string boardData = data.substr(pos);
-  size_t start = 0;
-  size_t end = boardData.find(',', start);
-  while (end != std::string::npos) {
-    std::string tileData = boardData.substr(start, end - start);
-    Colour colour = tileData[0];
-    size_t atPos = tileData.find('@');
-    if (atPos == std::string::npos) {
-      std::cerr << "Error: Invalid tile data format - " << tileData
-                << std::endl;
-      return nullptr;
-    }
-
-    Shape shape = std::stoi(tileData.substr(1, atPos - 1));
-    std::string position = tileData.substr(atPos + 1);
-
-    if (position.length() < 2) {
-      std::cerr << "Error: Invalid tile position format - " << position
-                << std::endl;
-      return nullptr;
-    }
-
-    int row = position[0] - 'A';
-    int col = std::stoi(position.substr(1));
-    board->placeTile(row, col, new Tile(colour, shape));
-
-    start = end + 1;
-    end = boardData.find(',', start);
-  }
-
-  // Process the last tile data
-  if (start < boardData.length()) {
-    std::string tileData = boardData.substr(start);
-
-    Colour colour = tileData[0];
-    size_t atPos = tileData.find('@');
-    if (atPos == std::string::npos) {
-      std::cerr << "Error: Invalid tile data format - " << tileData
-                << std::endl;
-      return nullptr;
-    }
-
-    Shape shape = std::stoi(tileData.substr(1, atPos - 1));
-    std::string position = tileData.substr(atPos + 1);
-
-    if (position.length() < 2) {
-      std::cerr << "Error: Invalid tile position format - " << position
-                << std::endl;
-      return nullptr;
-    }
-
-    int row = position[0] - 'A';
-    int col = std::stoi(position.substr(1));
-    board->placeTile(row, col, new Tile(colour, shape));
-  }
-
-  return board;
-}
+    TextView current;
+    if (!parser.readLine(current)) {
+        return false;
+    }
 
-/*
- * Deserialize the current player from a string
- * This function sets the current player's name
- * from a string representation.
- */
-void FileHandler::deserialiseCurrentPlayer(Player* currentPlayer, const std::string& data) {
-    currentPlayer->setName(data);
-}
+    bool loadedAiMode = false;
+    if (!parser.atEnd()) {
+        TextView gameMode;
+        if (!parser.readLine(gameMode)) {
+            return false;
+        }
+        if (!(gameMode == "AI" || gameMode == "STD" || gameMode == "")) {
+            return parser.fail("Game mode must be AI or STD");
+        }
+        loadedAiMode = gameMode == "AI";
+    }
+    if (!parser.atEnd()) {
+        std::uint64_t seed = 0;
+        std::uint64_t state = 0;
+        if (!parser.readPair(seed, state)) {
+            return false;
+        }
+        loadedBag.setRandomState(seed, state);
+    }
+    while (!parser.atEnd()) {
+        TextView extra;
+        if (!parser.readLine(extra)) {
+            return false;
+        }
+        if (extra.length > 0) {
+            return parser.fail("Unexpected line after the end of the save");
+        }
+    }
 
-void FileHandler::deserialiseGameMode(bool &aiMode, const std::string& data) {
-    data == "AI" ? aiMode = true : aiMode = false;
-}
\ No newline at end of file
+    Player* players[2] = {player1, player2};
+    for (int i = 0; i < 2; ++i) {
+        players[i]->setName(names[i].toString());
+        players[i]->setScore(scores[i]);
+        *players[i]->getHand() = hands[i];
+    }
+    if (board) {
+        loadedBoard.setEnhancedMode(board->getEnhancedMode());
+        *board = std::move(loadedBoard);
+    } else {
+        board = new GameBoard(std::move(loadedBoard));
+    }
+    *tileBag = loadedBag;
+    currentPlayer->setName(current.toString());
+    aiMode = loadedAiMode;
+    return true;
+}
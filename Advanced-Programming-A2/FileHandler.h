@@ -1,32 +1,50 @@
 #ifndef ASSIGN2_FILEHANDLER_H
 #define ASSIGN2_FILEHANDLER_H
 
+#include <cstddef>
 #include <string>
 #include "Player.h"
 #include "TileBag.h"
 #include "GameBoard.h"
 
+class SaveParser;
+struct SaveSnapshot;
+
+// Added to a save's file name while a new copy of it is being written
+#define SAVE_TEMP_EXTENSION ".tmp"
+
+// Most rows a text save can hold, one for each row letter
+#define MAX_TEXT_SAVE_ROWS 26
+
 class FileHandler {
 public:
     void saveGame(const std::string& filename, Player* player1, Player* player2, TileBag* tileBag, GameBoard* board, Player* currentPlayer, bool aiMode);
-    bool loadGame(const std::string& filename, Player* player1, Player* player2, TileBag* tileBag, GameBoard*& board, Player* currentPlayer, bool &aiMode);
+    // Turns in the save's journal are applied after loading it unless applyJournal is false
+    bool loadGame(const std::string& filename, Player* player1, Player* player2, TileBag* tileBag, GameBoard*& board, Player* currentPlayer, bool &aiMode, bool applyJournal = true);
     static bool fileExists(const std::string& filename);
+    // Check if a file name asks for the binary save format
+    static bool isBinarySave(const std::string& filename);
+
+    // Write a snapshot to its file, replacing the old file only once the new one is complete.
+    // Prints nothing, so it can run off the game thread. False with the reason in error.
+    static bool writeSnapshot(const SaveSnapshot& snapshot, std::string& error);
+
+    // The binary format, see SaveFormat.h. saveGame and loadGame use it for file names ending in
+    // BINARY_SAVE_EXTENSION. Loading maps the file and rejects it unless its checksum matches.
+    bool loadBinaryGame(const std::string& filename, Player* player1, Player* player2, TileBag* tileBag, GameBoard*& board, Player* currentPlayer, bool &aiMode, bool applyJournal = true);
     std::string readFileContent(const std::string& filename) const;
 
 private:
-    static std::string serialisePlayer(Player* player);
-    static std::string serialiseTileBag(TileBag* tileBag);
-    static std::string serialiseBoard(GameBoard* board);
-    std::string serialiseCurrentPlayer(Player* currentPlayer);
-
-    static void deserialisePlayer(Player* player, const std::string& data);
-    static void deserialiseTileBag(TileBag* tileBag, const std::string& data);
-    GameBoard* deserialiseBoard(const std::string& data);
-    void deserialiseCurrentPlayer(Player* currentPlayer, const std::string& data);
-    void deserialiseGameMode(bool &aiMode, const std::string& data);
-
-    static std::vector<Tile*> linkedListToVector(LinkedList* list);
-    static void vectorToLinkedList(const std::vector<Tile*>& vec, LinkedList* list);
+    static bool serialiseTextGame(const SaveSnapshot& snapshot, std::string& result, std::string& error);
+    static void serialiseTile(std::string& result, Tile tile, bool& first);
+    static bool serialiseBinaryGame(const SaveSnapshot& snapshot, std::string& data, std::string& error);
+    static bool replaceFile(const std::string& filename, const std::string& data, std::string& error);
+
+    // Apply the journal beside a save that has just been loaded from data
+    void replayJournal(const std::string& filename, const unsigned char* data, std::size_t size, Player* player1, Player* player2, TileBag* tileBag, GameBoard* board, Player* currentPlayer);
+
+    // Read a whole text save, false with the parser holding the error if any line is invalid
+    bool parseTextGame(SaveParser& parser, Player* player1, Player* player2, TileBag* tileBag, GameBoard*& board, Player* currentPlayer, bool &aiMode);
 };
 
 #endif // ASSIGN2_FILEHANDLER_H
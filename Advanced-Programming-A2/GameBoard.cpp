@@ -1,110 +1,186 @@
 #include <iostream>
+#include <algorithm>
 #include "GameBoard.h"
+#include "TileCodes.h"
+#include "Rules.h"
 
 // Constructor
-GameBoard::GameBoard() : rows(26), cols(26), board(rows, std::vector<Tile*>(cols, nullptr)), enhancedMode(false) {
+GameBoard::GameBoard() : rows(26), cols(26), board(paddedSize(rows, cols), EMPTY_TILE), enhancedMode(false) {
+    recalculateBounds();
+    recalculateFrontier();
+    recalculateRuns();
 }
 
 // Parameterized Constructor
-GameBoard::GameBoard(int rows, int cols) : rows(rows), cols(cols), board(rows, std::vector<Tile*>(cols, nullptr)), enhancedMode(false) {
+GameBoard::GameBoard(int rows, int cols) : rows(rows), cols(cols), board(paddedSize(rows, cols), EMPTY_TILE), enhancedMode(false) {
+    recalculateBounds();
+    recalculateFrontier();
+    recalculateRuns();
 }
 
 // Destructor
 GameBoard::~GameBoard() {
-    // Destructor cleans up the dynamically allocated tiles
-    for (int row = 0; row < rows; ++row) {
-        for (int col = 0; col < cols; ++col) {
-            if (board[row][col] != nullptr) {
-                delete board[row][col];  
-            }
-        }
-    }
 }
 
 // Copy constructor
 GameBoard::GameBoard(const GameBoard& other)
     : rows(other.rows),
       cols(other.cols),
-      board(rows, std::vector<Tile*>(cols, nullptr)) {
-  for (int row = 0; row < rows; ++row) {
-    for (int col = 0; col < cols; ++col) {
-      if (other.board[row][col] != nullptr) {
-        board[row][col] = new Tile(*other.board[row][col]);
-      }
-    }
-  }
+      board(other.board),
+      enhancedMode(other.enhancedMode),
+      tileCount(other.tileCount),
+      minRow(other.minRow),
+      maxRow(other.maxRow),
+      minCol(other.minCol),
+      maxCol(other.maxCol),
+      tileCounts(other.tileCounts),
+      frontier(other.frontier),
+      frontierPosition(other.frontierPosition),
+      rowRuns(other.rowRuns),
+      columnRuns(other.columnRuns),
+      legalTiles(other.legalTiles) {
 }
 
 // Copy assignment operator
 GameBoard& GameBoard::operator=(const GameBoard& other) {
   if (this != &other) {
-    // Clean up current resources
-    for (int row = 0; row < rows; ++row) {
-      for (int col = 0; col < cols; ++col) {
-        delete board[row][col];
-      }
-    }
-
-    // Copy new values
     rows = other.rows;
     cols = other.cols;
-    board = std::vector<std::vector<Tile*>>(rows,
-                                            std::vector<Tile*>(cols, nullptr));
-
-    for (int row = 0; row < rows; ++row) {
-      for (int col = 0; col < cols; ++col) {
-        if (other.board[row][col] != nullptr) {
-          board[row][col] = new Tile(*other.board[row][col]);
-        }
-      }
-    }
+    board = other.board;
+    enhancedMode = other.enhancedMode;
+    tileCount = other.tileCount;
+    tileCounts = other.tileCounts;
+    minRow = other.minRow;
+    maxRow = other.maxRow;
+    minCol = other.minCol;
+    maxCol = other.maxCol;
+    frontier = other.frontier;
+    frontierPosition = other.frontierPosition;
+    rowRuns = other.rowRuns;
+    columnRuns = other.columnRuns;
+    legalTiles = other.legalTiles;
   }
   return *this;
 }
 
 // Move constructor
 GameBoard::GameBoard(GameBoard&& other)
-    : rows(other.rows), cols(other.cols), board(std::move(other.board)) {
+    : rows(other.rows),
+      cols(other.cols),
+      board(std::move(other.board)),
+      enhancedMode(other.enhancedMode),
+      tileCount(other.tileCount),
+      minRow(other.minRow),
+      maxRow(other.maxRow),
+      minCol(other.minCol),
+      maxCol(other.maxCol),
+      tileCounts(other.tileCounts),
+      frontier(std::move(other.frontier)),
+      frontierPosition(std::move(other.frontierPosition)),
+      rowRuns(std::move(other.rowRuns)),
+      columnRuns(std::move(other.columnRuns)),
+      legalTiles(std::move(other.legalTiles)) {
   other.rows = 0;
   other.cols = 0;
+  other.board.assign(paddedSize(0, 0), EMPTY_TILE);
+  other.recalculateBounds();
+  other.recalculateFrontier();
+  other.recalculateRuns();
 }
 
 // Move assignment operator
 GameBoard& GameBoard::operator=(GameBoard&& other) {
   if (this != &other) {
-    // Clean up current resources
-    for (int row = 0; row < rows; ++row) {
-      for (int col = 0; col < cols; ++col) {
-        delete board[row][col];
-      }
-    }
-
-    // Move new values
     rows = other.rows;
     cols = other.cols;
     board = std::move(other.board);
+    enhancedMode = other.enhancedMode;
+    tileCount = other.tileCount;
+    tileCounts = other.tileCounts;
+    minRow = other.minRow;
+    maxRow = other.maxRow;
+    minCol = other.minCol;
+    maxCol = other.maxCol;
+    frontier = std::move(other.frontier);
+    frontierPosition = std::move(other.frontierPosition);
+    rowRuns = std::move(other.rowRuns);
+    columnRuns = std::move(other.columnRuns);
+    legalTiles = std::move(other.legalTiles);
 
     other.rows = 0;
     other.cols = 0;
+    other.board.assign(paddedSize(0, 0), EMPTY_TILE);
+    other.recalculateBounds();
+    other.recalculateFrontier();
+    other.recalculateRuns();
   }
   return *this;
 }
 
 // Place a tile on the board
-void GameBoard::placeTile(int row, int col, Tile* tile) {
-    if (row >= 0 && row < rows && col >= 0 && col < cols) {
-        board[row][col] = tile;
+void GameBoard::placeTile(int row, int col, Tile tile) {
+    if (onBoard(row, col)) {
+        int index = cellIndex(row, col);
+        TileCode previous = board[index];
+        TileCode code = tile.getCode();
+        board[index] = code;
+
+        countTile(previous, -1);
+        countTile(code, 1);
+
+        if (previous == EMPTY_TILE && code != EMPTY_TILE) {
+            // Grow the bounding box to cover the new tile
+            tileCount++;
+            minRow = std::min(minRow, row);
+            maxRow = std::max(maxRow, row);
+            minCol = std::min(minCol, col);
+            maxCol = std::max(maxCol, col);
+
+            // The cell is now filled and its empty neighbours now touch a tile
+            removeFromFrontier(row, col);
+            addToFrontier(row - 1, col);
+            addToFrontier(row + 1, col);
+            addToFrontier(row, col - 1);
+            addToFrontier(row, col + 1);
+        } else if (previous != EMPTY_TILE && code == EMPTY_TILE) {
+            tileCount--;
+            // Only a tile on the edge of the box can shrink it
+            if (row == minRow || row == maxRow || col == minCol || col == maxCol) {
+                recalculateBounds();
+            }
+
+            // The emptied cell may still touch a tile, its neighbours may no longer
+            addToFrontier(row, col);
+            const int neighbours[4][2] = {{row - 1, col}, {row + 1, col}, {row, col - 1}, {row, col + 1}};
+            for (const auto& neighbour : neighbours) {
+                if (onBoard(neighbour[0], neighbour[1]) && !hasNeighbourTile(neighbour[0], neighbour[1])) {
+                    removeFromFrontier(neighbour[0], neighbour[1]);
+                }
+            }
+        }
+
+        // Only the row and column through the cell can have changed
+        if (previous != code) {
+            updateRuns(row, col, 0, 1, rowRuns);
+            updateRuns(row, col, 1, 0, columnRuns);
+            updateLegalTiles(row, col);
+        }
     } else {
         std::cout << "Invalid position [" << row << "][" << col << "] for placing tile." << std::endl;
     }
 }
 
 // Get a tile from the board
-Tile* GameBoard::getTile(int row, int col) const {
-    if (row >= 0 && row < rows && col >= 0 && col < cols) {
-        return board[row][col];
+Tile GameBoard::getTile(int row, int col) const {
+    return Tile::fromCode(getTileCode(row, col));
+}
+
+// Get a packed tile code from the board, the border around the board reads as empty cells
+TileCode GameBoard::getTileCode(int row, int col) const {
+    if (inPadding(row, col)) {
+        return board[cellIndex(row, col)];
     }
-    return nullptr;
+    return EMPTY_TILE;
 }
 
 // Get the number of rows
@@ -142,11 +218,12 @@ std::string GameBoard::displayBoard() const {
     for (int row = 0; row < rows; ++row) {
         output += std::string(1, 'A' + row) + "|";
         for (int col = 0; col < cols; ++col) {
-            if (board[row][col] != nullptr) {
+            Tile tile = getTile(row, col);
+            if (!tile.isEmpty()) {
                 if (enhancedMode) {
-                  output +=  board[row][col]->enhancedPrint() + "|";
+                  output +=  tile.enhancedPrint() + "|";
                 } else {
-                  output += board[row][col]->print() + "|";
+                  output += tile.print() + "|";
                 }
             } else {
                 output += "  |";
@@ -160,25 +237,283 @@ std::string GameBoard::displayBoard() const {
 
 // Check if the board is empty
 bool GameBoard::isEmpty() const {
+    return tileCount == 0;
+}
+
+int GameBoard::getTileCount() const {
+    return tileCount;
+}
+
+int GameBoard::getTileCount(Tile tile) const {
+    int index = Tile::tileIndex(tile.getCode());
+    return index < 0 ? 0 : tileCounts[index];
+}
+
+void GameBoard::countTile(TileCode code, int change) {
+    int index = Tile::tileIndex(code);
+    if (index >= 0) {
+        tileCounts[index] += change;
+    }
+}
+
+int GameBoard::getMinRow() const {
+    return minRow;
+}
+
+int GameBoard::getMaxRow() const {
+    return maxRow;
+}
+
+int GameBoard::getMinCol() const {
+    return minCol;
+}
+
+int GameBoard::getMaxCol() const {
+    return maxCol;
+}
+
+const std::vector<BoardCell>& GameBoard::getFrontier() const {
+    return frontier;
+}
+
+bool GameBoard::isFrontier(int row, int col) const {
+    if (inPadding(row, col)) {
+        return frontierPosition[cellIndex(row, col)] != -1;
+    }
+    return false;
+}
+
+// Rebuild the tile count and bounding box from the grid
+void GameBoard::recalculateBounds() {
+    tileCount = 0;
+    tileCounts.fill(0);
+    minRow = rows;
+    maxRow = -1;
+    minCol = cols;
+    maxCol = -1;
     for (int row = 0; row < rows; ++row) {
         for (int col = 0; col < cols; ++col) {
-            if (board[row][col] != nullptr) {
-                return false;
+            TileCode code = cell(row, col);
+            if (code != EMPTY_TILE) {
+                tileCount++;
+                countTile(code, 1);
+                minRow = std::min(minRow, row);
+                maxRow = std::max(maxRow, row);
+                minCol = std::min(minCol, col);
+                maxCol = std::max(maxCol, col);
             }
         }
     }
-    return true;
 }
 
 // Resize the board
 void GameBoard::resize(int newRows, int newCols) {
     std::cout << "Resizing board to " << newRows << "x" << newCols << "." << std::endl;
-    board.resize(newRows);
-    for (auto& row : board) {
-        row.resize(newCols, nullptr);
+    // Keep every tile at the same row and column that still fits
+    BoardCells resized(paddedSize(newRows, newCols), EMPTY_TILE);
+    for (int row = 0; row < rows && row < newRows; ++row) {
+        for (int col = 0; col < cols && col < newCols; ++col) {
+            resized[(row + 1) * (newCols + 2) + col + 1] = cell(row, col);
+        }
     }
+    board = std::move(resized);
     rows = newRows;
     cols = newCols;
+    recalculateBounds();
+    recalculateFrontier();
+    recalculateRuns();
+}
+
+// Rebuild the frontier from the grid
+void GameBoard::recalculateFrontier() {
+    frontier.clear();
+    frontierPosition.assign(board.size(), -1);
+    // Relies on recalculateBounds having counted the tiles first
+    if (tileCount == 0) {
+        return;
+    }
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            addToFrontier(row, col);
+        }
+    }
+}
+
+// Add an empty cell that touches a tile to the frontier, ignoring any other cell
+void GameBoard::addToFrontier(int row, int col) {
+    if (!onBoard(row, col)) {
+        return;
+    }
+    int index = cellIndex(row, col);
+    if (frontierPosition[index] == -1 && board[index] == EMPTY_TILE && hasNeighbourTile(row, col)) {
+        frontierPosition[index] = frontier.size();
+        frontier.push_back({row, col});
+    }
+}
+
+// Remove a cell from the frontier by swapping the last frontier cell into its slot
+void GameBoard::removeFromFrontier(int row, int col) {
+    int index = cellIndex(row, col);
+    int position = frontierPosition[index];
+    if (position != -1) {
+        BoardCell last = frontier.back();
+        frontier[position] = last;
+        frontierPosition[cellIndex(last.row, last.col)] = position;
+        frontier.pop_back();
+        frontierPosition[index] = -1;
+    }
+}
+
+const LineRun& GameBoard::getRowRun(int row, int col) const {
+    static const LineRun noRun = {0, 0, 0};
+    if (inPadding(row, col)) {
+        return rowRuns[cellIndex(row, col)];
+    }
+    return noRun;
+}
+
+const LineRun& GameBoard::getColumnRun(int row, int col) const {
+    static const LineRun noRun = {0, 0, 0};
+    if (inPadding(row, col)) {
+        return columnRuns[cellIndex(row, col)];
+    }
+    return noRun;
+}
+
+TileMask GameBoard::getLegalTiles(int row, int col) const {
+    if (inPadding(row, col)) {
+        return legalTiles[cellIndex(row, col)];
+    }
+    return 0;
+}
+
+// The border means a cell on the edge of the board reads its missing neighbours as empty
+bool GameBoard::hasNeighbourTile(int row, int col) const {
+    int index = cellIndex(row, col);
+    int stride = cols + 2;
+    return (board[index - stride] | board[index + stride] | board[index - 1] | board[index + 1]) != EMPTY_TILE;
+}
+
+// Rebuild the row and column runs of every cell from the grid
+void GameBoard::recalculateRuns() {
+    const LineRun noRun = {0, 0, 0};
+    rowRuns.assign(board.size(), noRun);
+    columnRuns.assign(board.size(), noRun);
+    legalTiles.assign(board.size(), 0);
+    // An empty board has no runs and no legal tiles, as for the frontier the tiles are counted first
+    if (tileCount == 0) {
+        return;
+    }
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            if (cell(row, col) != EMPTY_TILE) {
+                // Start a run at each tile that has no tile before it, the border ends every line
+                if (cell(row, col - 1) == EMPTY_TILE) {
+                    int endCol = col;
+                    while (cell(row, endCol + 1) != EMPTY_TILE) {
+                        endCol++;
+                    }
+                    assignRun(row, col, row, endCol, 0, 1, rowRuns);
+                }
+                if (cell(row - 1, col) == EMPTY_TILE) {
+                    int endRow = row;
+                    while (cell(endRow + 1, col) != EMPTY_TILE) {
+                        endRow++;
+                    }
+                    assignRun(row, col, endRow, col, 1, 0, columnRuns);
+                }
+            }
+        }
+    }
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            assignGap(row, col, 0, 1, rowRuns);
+            assignGap(row, col, 1, 0, columnRuns);
+        }
+    }
+}
+
+// Refresh the runs along the line through row, col. Only the tiles touching the cell
+// and the empty cells at either end of them are affected.
+void GameBoard::updateRuns(int row, int col, int rowStep, int colStep, std::vector<LineRun>& runs) {
+    int startRow = row;
+    int startCol = col;
+    while (cell(startRow - rowStep, startCol - colStep) != EMPTY_TILE) {
+        startRow -= rowStep;
+        startCol -= colStep;
+    }
+    int endRow = row;
+    int endCol = col;
+    while (cell(endRow + rowStep, endCol + colStep) != EMPTY_TILE) {
+        endRow += rowStep;
+        endCol += colStep;
+    }
+
+    if (cell(row, col) != EMPTY_TILE) {
+        assignRun(startRow, startCol, endRow, endCol, rowStep, colStep, runs);
+    } else {
+        // An emptied cell splits its line in two
+        if (startRow != row || startCol != col) {
+            assignRun(startRow, startCol, row - rowStep, col - colStep, rowStep, colStep, runs);
+        }
+        if (endRow != row || endCol != col) {
+            assignRun(row + rowStep, col + colStep, endRow, endCol, rowStep, colStep, runs);
+        }
+        assignGap(row, col, rowStep, colStep, runs);
+    }
+    assignGap(startRow - rowStep, startCol - colStep, rowStep, colStep, runs);
+    assignGap(endRow + rowStep, endCol + colStep, rowStep, colStep, runs);
+}
+
+void GameBoard::assignRun(int fromRow, int fromCol, int toRow, int toCol, int rowStep, int colStep, std::vector<LineRun>& runs) {
+    LineRun run = {0, 0, 0};
+    for (int row = fromRow, col = fromCol; ; row += rowStep, col += colStep) {
+        TileCode code = cell(row, col);
+        run.length++;
+        run.colours |= Tile::colourBit(code);
+        run.shapes |= Tile::shapeBit(code);
+        if (row == toRow && col == toCol) {
+            break;
+        }
+    }
+    for (int row = fromRow, col = fromCol; ; row += rowStep, col += colStep) {
+        runs[cellIndex(row, col)] = run;
+        if (row == toRow && col == toCol) {
+            break;
+        }
+    }
+}
+
+void GameBoard::assignGap(int row, int col, int rowStep, int colStep, std::vector<LineRun>& runs) {
+    if (!onBoard(row, col) || cell(row, col) != EMPTY_TILE) {
+        return;
+    }
+    int index = cellIndex(row, col);
+    int step = rowStep * (cols + 2) + colStep;
+    LineRun gap = {0, 0, 0};
+    const int sides[2] = {index - step, index + step};
+    for (int side : sides) {
+        if (board[side] != EMPTY_TILE) {
+            const LineRun& run = runs[side];
+            gap.length += run.length;
+            gap.colours |= run.colours;
+            gap.shapes |= run.shapes;
+        }
+    }
+    runs[index] = gap;
+    updateLegalTiles(row, col);
+}
+
+// Only an empty cell touching a tile can take one, and the tile must suit both of its lines
+void GameBoard::updateLegalTiles(int row, int col) {
+    int index = cellIndex(row, col);
+    const LineRun& rowRun = rowRuns[index];
+    const LineRun& columnRun = columnRuns[index];
+    if (board[index] != EMPTY_TILE || (rowRun.length == 0 && columnRun.length == 0)) {
+        legalTiles[index] = 0;
+    } else {
+        legalTiles[index] = Rules::lineLegalTiles(rowRun) & Rules::lineLegalTiles(columnRun);
+    }
 }
 
 void GameBoard::setEnhancedMode(bool enhancedMode) {
@@ -1,11 +1,29 @@
 #ifndef ASSIGN2_GAMEBOARD_H
 #define ASSIGN2_GAMEBOARD_H
 
+#include <array>
 #include <vector>
 #include <string>
 #include "Tile.h"
+#include "AlignedAllocator.h"
 #include <map>
 
+// Flat row-major grid of packed tile codes, with a border of empty cells around the board
+typedef std::vector<TileCode, AlignedAllocator<TileCode>> BoardCells;
+
+// Length and colour/shape masks of a line of tiles
+struct LineRun {
+    unsigned char length;
+    unsigned short colours;
+    unsigned short shapes;
+};
+
+// Row and column of a single board cell
+struct BoardCell {
+    int row;
+    int col;
+};
+
 class GameBoard {
 public:
     GameBoard();
@@ -23,11 +41,14 @@ public:
     // Move assignment operator
     GameBoard& operator=(GameBoard&& other);
 
-    // Place a tile at a specific position
-    void placeTile(int row, int col, Tile* tile);
+    // Place a tile at a specific position, the empty tile clears the cell
+    void placeTile(int row, int col, Tile tile);
+
+    // Get the tile at a specific position, the empty tile when there is none
+    Tile getTile(int row, int col) const;
 
-    // Get the tile at a specific position
-    Tile* getTile(int row, int col) const;
+    // Get the packed tile code at a specific position, EMPTY_TILE when empty or out of bounds
+    TileCode getTileCode(int row, int col) const;
 
     // Display the board
     std::string displayBoard() const;
@@ -39,6 +60,34 @@ public:
     // Check if the board is empty
     bool isEmpty() const;
 
+    // Number of tiles currently on the board
+    int getTileCount() const;
+
+    // Copies of one tile currently on the board
+    int getTileCount(Tile tile) const;
+
+    // Bounding box of placed tiles, min > max while the board is empty
+    int getMinRow() const;
+    int getMaxRow() const;
+    int getMinCol() const;
+    int getMaxCol() const;
+
+    // Empty cells that touch at least one tile, the only cells a tile can be placed in
+    // once the board has tiles. Order is unspecified and changes as tiles are placed.
+    const std::vector<BoardCell>& getFrontier() const;
+
+    // Check if an empty cell touches a tile
+    bool isFrontier(int row, int col) const;
+
+    // Line of tiles through a cell along its row (changing column) or its column (changing row).
+    // For a tile this is the line it is part of, for an empty cell it is the tiles on either
+    // side that a tile placed there would join, excluding the cell itself.
+    const LineRun& getRowRun(int row, int col) const;
+    const LineRun& getColumnRun(int row, int col) const;
+
+    // Tiles that could legally be placed in a cell, 0 for any cell off the frontier
+    TileMask getLegalTiles(int row, int col) const;
+
     // Resize the board
     void resize(int rows, int cols);
     
@@ -49,8 +98,78 @@ public:
 private:    
     int rows;
     int cols;
-    std::vector<std::vector<Tile*>> board;
+    // Each row is cols + 2 cells wide and there is an extra row above and below, so every
+    // cell on the board has four neighbours to read without checking the edges. The border
+    // is always empty, its runs are empty and it is never on the frontier.
+    BoardCells board;
     bool enhancedMode;
+
+    // Occupancy tracking kept up to date by placeTile and resize
+    int tileCount;
+    int minRow;
+    int maxRow;
+    int minCol;
+    int maxCol;
+
+    // Copies of each tile on the board, indexed by Tile::tileIndex
+    std::array<unsigned short, TILE_MASK_BITS> tileCounts;
+
+    // Frontier cells, with each cell's index into frontier or -1 when it is not on the frontier
+    std::vector<BoardCell> frontier;
+    std::vector<int> frontierPosition;
+
+    // Line runs through every cell, indexed like board
+    std::vector<LineRun> rowRuns;
+    std::vector<LineRun> columnRuns;
+
+    // Legal tiles for every cell, recomputed whenever one of the cell's runs changes
+    std::vector<TileMask> legalTiles;
+
+    // Cells needed to store a board with its border
+    static int paddedSize(int rows, int cols) { return (rows + 2) * (cols + 2); }
+
+    // Position of a cell in board and the other per-cell vectors, valid from -1 to rows and cols
+    int cellIndex(int row, int col) const { return (row + 1) * (cols + 2) + col + 1; }
+
+    // Tile code of a cell on the board or its border, unchecked
+    TileCode cell(int row, int col) const { return board[cellIndex(row, col)]; }
+
+    // Check if a cell is on the board, or on the board or its border
+    bool onBoard(int row, int col) const { return (unsigned)row < (unsigned)rows && (unsigned)col < (unsigned)cols; }
+    bool inPadding(int row, int col) const {
+        return (unsigned)(row + 1) < (unsigned)(rows + 2) && (unsigned)(col + 1) < (unsigned)(cols + 2);
+    }
+
+    // Add or take away one copy of a tile in tileCounts, codes with no index are ignored
+    void countTile(TileCode code, int change);
+
+    // Rescan the grid to rebuild the tile counts and bounding box
+    void recalculateBounds();
+
+    // Rescan the grid to rebuild the frontier
+    void recalculateFrontier();
+
+    // O(1) frontier membership updates
+    void addToFrontier(int row, int col);
+    void removeFromFrontier(int row, int col);
+
+    // Check if any orthogonal neighbour of a cell on the board holds a tile
+    bool hasNeighbourTile(int row, int col) const;
+
+    // Rescan the grid to rebuild every line run
+    void recalculateRuns();
+
+    // Refresh the runs along one line after the cell at row, col changed
+    void updateRuns(int row, int col, int rowStep, int colStep, std::vector<LineRun>& runs);
+
+    // Store the run covering the tiles from one cell to another along a line
+    void assignRun(int fromRow, int fromCol, int toRow, int toCol, int rowStep, int colStep, std::vector<LineRun>& runs);
+
+    // Recompute an empty cell's run from the tiles on either side of it
+    void assignGap(int row, int col, int rowStep, int colStep, std::vector<LineRun>& runs);
+
+    // Recompute the legal tiles of a cell from its row and column runs
+    void updateLegalTiles(int row, int col);
 };
 
 #endif // ASSIGN2_GAMEBOARD_H
@@ -0,0 +1,71 @@
+#include "Hand.h"
+#include <sstream>
+#include <stdexcept>
+
+Hand::Hand() : length(0), counts(), mask(0) {}
+
+bool Hand::add(Tile tile) {
+    int index = Tile::tileIndex(tile.getCode());
+    if (index < 0 || isFull()) {
+        return false;
+    }
+    tiles[length++] = tile;
+    counts[index]++;
+    mask |= 1ull << index;
+    return true;
+}
+
+bool Hand::remove(Tile tile) {
+    int index = Tile::tileIndex(tile.getCode());
+    if (index < 0 || counts[index] == 0) {
+        return false;
+    }
+
+    // Close the gap so the rest of the hand keeps its order
+    int position = 0;
+    while (tiles[position] != tile) {
+        ++position;
+    }
+    for (int i = position + 1; i < length; ++i) {
+        tiles[i - 1] = tiles[i];
+    }
+    length--;
+
+    if (--counts[index] == 0) {
+        mask &= ~(1ull << index);
+    }
+    return true;
+}
+
+void Hand::clear() {
+    *this = Hand();
+}
+
+Tile Hand::get(int index) const {
+    if (index < 0 || index >= length) {
+        throw std::out_of_range("Index out of range");
+    }
+    return tiles[index];
+}
+
+std::string Hand::toString() const {
+    std::ostringstream oss;
+    for (int i = 0; i < length; ++i) {
+        if (i > 0) {
+            oss << ", ";
+        }
+        oss << tiles[i];
+    }
+    return oss.str();
+}
+
+std::string Hand::enhancedPrint() const {
+    std::ostringstream oss;
+    for (int i = 0; i < length; ++i) {
+        if (i > 0) {
+            oss << ", ";
+        }
+        oss << tiles[i] << tiles[i].enhancedPrint();
+    }
+    return oss.str();
+}
@@ -0,0 +1,58 @@
+#ifndef ASSIGN2_HAND_H
+#define ASSIGN2_HAND_H
+
+#include <string>
+#include "Tile.h"
+
+// Most tiles a player can hold
+#define MAX_HAND_SIZE 6
+
+/*
+ * The tiles in a player's hand, held inline in the order they were added.
+ * A count per tile and a mask of the tiles present make membership checks a
+ * single lookup. A hand has no pointers, so it is copied as plain bytes.
+ */
+class Hand {
+public:
+    Hand();
+
+    // Add a tile to the end of the hand, false if the hand is full or the tile is not a real tile
+    bool add(Tile tile);
+
+    // Remove the first copy of a tile, false if the hand does not have it
+    bool remove(Tile tile);
+
+    void clear();
+
+    // Check if the hand holds a tile, or how many copies of it
+    bool contains(Tile tile) const { return count(tile) > 0; }
+    int count(Tile tile) const {
+        int index = Tile::tileIndex(tile.getCode());
+        return index < 0 ? 0 : counts[index];
+    }
+
+    // Every distinct tile in the hand, ready to AND against the board's legal tile masks
+    TileMask getMask() const { return mask; }
+
+    Tile get(int index) const;
+    int getLength() const { return length; }
+    bool isEmpty() const { return length == 0; }
+    bool isFull() const { return length == MAX_HAND_SIZE; }
+
+    // Iterate over the tiles in order
+    const Tile* begin() const { return tiles; }
+    const Tile* end() const { return tiles + length; }
+
+    std::string toString() const;
+    std::string enhancedPrint() const;
+
+private:
+    Tile tiles[MAX_HAND_SIZE];
+    unsigned char length;
+    unsigned char counts[TILE_MASK_BITS];
+    TileMask mask;
+};
+
+static_assert(std::is_trivially_copyable<Hand>::value, "Hands are copied as plain bytes");
+
+#endif // ASSIGN2_HAND_H
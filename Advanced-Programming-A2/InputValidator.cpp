@@ -1,6 +1,7 @@
 #include "InputValidator.h"
 #include <cctype>
 #include <regex>
+#include "TileSet.h"
 
 bool InputValidator::isValidName(const std::string& name) {
     if (name.empty()) return false;
@@ -11,26 +12,29 @@ bool InputValidator::isValidName(const std::string& name) {
 }
 
 bool InputValidator::isFileNameValid(const std::string& filename) {
-    // Check if filename is not empty and contains only valid characters ending with .txt
-    std::regex validFileNamePattern("^[a-zA-Z0-9./_-]+\\.txt$");
+    // Check if filename is not empty and contains only valid characters ending with .txt,
+    // or .qwb for a binary save
+    std::regex validFileNamePattern("^[a-zA-Z0-9./_-]+\\.(txt|qwb)$");
     bool isValid = !filename.empty() && std::regex_match(filename, validFileNamePattern);
     return isValid;
 }
 
 // Check if the file format is valid according to the specified game format
 bool InputValidator::isFileFormatValid(const std::string& data) {
-std::regex validFileFormatPattern(
-    "^[a-zA-Z0-9 ]+\n"               // Player 1 name
-    "\\d+\n"                         // Player 1 score
-    "([A-Z][1-6],)*[A-Z][1-6]?\n"    // Player 1 hand
-    "[a-zA-Z0-9 ]+\n"                // Player 2 name
-    "\\d+\n"                         // Player 2 score
-    "([A-Z][1-6],)*[A-Z][1-6]?\n"    // Player 2 hand
-    "\\d+,\\d+\n"                    // Board size
-    "([A-Z][1-6]@\\w\\d,)*([A-Z][1-6]@\\w\\d)\n" // Board tiles
-    "([A-Z][1-6],)*[A-Z][1-6]?\n"    // Tile bag contents
-    "[a-zA-Z0-9 ]+$"                 // Current player name
-);
+    // Tiles follow the tile set in play, a colour letter and a shape from 1 up
+    std::string tile = "[A-Z][1-" + std::to_string(TileSet::getShapes()) + "]";
+    std::regex validFileFormatPattern(
+        "^[a-zA-Z0-9 ]+\n"                                   // Player 1 name
+        "\\d+\n"                                             // Player 1 score
+        "(" + tile + ",)*" + tile + "?\n"                    // Player 1 hand
+        "[a-zA-Z0-9 ]+\n"                                    // Player 2 name
+        "\\d+\n"                                             // Player 2 score
+        "(" + tile + ",)*" + tile + "?\n"                    // Player 2 hand
+        "\\d+,\\d+\n"                                        // Board size
+        "(" + tile + "@\\w\\d,)*(" + tile + "@\\w\\d)\n"     // Board tiles
+        "(" + tile + ",)*" + tile + "?\n"                    // Tile bag contents
+        "[a-zA-Z0-9 ]+$"                                     // Current player name
+    );
 
     return std::regex_match(data, validFileFormatPattern);
 }
@@ -1,42 +1,331 @@
 #ifndef ASSIGN2_LINKEDLIST_H
 #define ASSIGN2_LINKEDLIST_H
 
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include "Node.h"
+#include "NodePool.h"
 
+/*
+ * A doubly linked list of values. Both ends add and remove in constant time,
+ * and get remembers the last node it reached so walking the list by index
+ * costs one step per call rather than a walk from the head.
+ */
+template <typename T>
 class LinkedList {
  public:
-  LinkedList();
-  ~LinkedList();
-  LinkedList(const LinkedList& other);
-  LinkedList& operator=(const LinkedList& other);
-  LinkedList(LinkedList&& other);
-  LinkedList& operator=(LinkedList&& other);
-
-  void addBack(Tile* tile);
-  void addFront(Tile* tile);
-  Tile* remove(Tile* tile);
-  Tile* removeFront();
-  Tile* removeEnd();
-  void clear();
-
-  Node* getHead() const;
-  int getLength() const;
-  bool isEmpty() const;
-  // std::string toString();
-  std::string toString() const;
-
-  Tile* get(int index) const;
-  void deleteFront();
-  void deleteBack();
-  void addAt(Tile* tile, int index);
-  void deleteAt(int index);
-
-  std::string enhancedPrint() const;
+  // Iterators stay valid until the node they point at is removed
+  template <bool Const>
+  class Iterator {
+   public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<Const, const T*, T*>::type pointer;
+    typedef typename std::conditional<Const, const T&, T&>::type reference;
+
+    Iterator() : list(nullptr), node(nullptr) {}
+    // A mutable iterator can always be read as a const one
+    Iterator(const Iterator<false>& other) : list(other.list), node(other.node) {}
+
+    reference operator*() const { return node->getValue(); }
+    pointer operator->() const { return &node->getValue(); }
+
+    Iterator& operator++() {
+      node = node->getNext();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+    // Stepping back from the end reaches the last value
+    Iterator& operator--() {
+      node = node == nullptr ? list->tail : node->getPrev();
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator previous = *this;
+      --*this;
+      return previous;
+    }
+
+    bool operator==(const Iterator& other) const { return node == other.node; }
+    bool operator!=(const Iterator& other) const { return node != other.node; }
+
+   private:
+    friend class LinkedList;
+    template <bool> friend class Iterator;
+    typedef typename std::conditional<Const, const LinkedList*, LinkedList*>::type ListPointer;
+
+    Iterator(ListPointer list, Node<T>* node) : list(list), node(node) {}
+
+    ListPointer list;
+    Node<T>* node;
+  };
+
+  typedef Iterator<false> iterator;
+  typedef Iterator<true> const_iterator;
+
+  LinkedList() : LinkedList(nullptr) {}
+  // Take nodes from a pool instead of the heap, the pool has to outlive the list
+  explicit LinkedList(NodePool<T>* pool)
+      : pool(pool), head(nullptr), tail(nullptr), size(0), cursor(nullptr), cursorIndex(0) {}
+  ~LinkedList() { clear(); }
+
+  // Copy constructor, the copy takes its nodes from the same pool
+  LinkedList(const LinkedList& other) : LinkedList(other.pool) {
+    for (const T& value : other) {
+      addBack(value);
+    }
+  }
+
+  // Copy assignment operator
+  LinkedList& operator=(const LinkedList& other) {
+    if (this != &other) {
+      clear();
+      for (const T& value : other) {
+        addBack(value);
+      }
+    }
+    return *this;
+  }
+
+  // Move constructor, the nodes move with the pool they came from
+  LinkedList(LinkedList&& other) : LinkedList(other.pool) {
+    take(other);
+  }
+
+  // Move assignment operator
+  LinkedList& operator=(LinkedList&& other) {
+    if (this != &other) {
+      // Clean up the current state
+      clear();
+      pool = other.pool;
+      take(other);
+    }
+    return *this;
+  }
+
+  iterator begin() { return iterator(this, head); }
+  iterator end() { return iterator(this, nullptr); }
+  const_iterator begin() const { return const_iterator(this, head); }
+  const_iterator end() const { return const_iterator(this, nullptr); }
+
+  void addBack(T value) {
+    Node<T>* added = newNode(value);
+    added->setPrev(tail);
+    if (tail == nullptr) {
+      head = added;
+    } else {
+      tail->setNext(added);
+    }
+    tail = added;
+    size++;
+  }
+
+  void addFront(T value) {
+    Node<T>* added = newNode(value);
+    added->setNext(head);
+    if (head == nullptr) {
+      tail = added;
+    } else {
+      head->setPrev(added);
+    }
+    head = added;
+    size++;
+    // Every index has moved along by one
+    cursor = nullptr;
+  }
+
+  // The removing functions return a default value when there is nothing to remove
+  T remove(T value) {
+    for (Node<T>* current = head; current != nullptr; current = current->getNext()) {
+      if (current->getValue() == value) {
+        return unlink(current);
+      }
+    }
+    return T();
+  }
+
+  T removeFront() {
+    if (head == nullptr) {
+      return T();
+    }
+    return unlink(head);
+  }
+
+  T removeEnd() {
+    if (tail == nullptr) {
+      throw std::underflow_error("List is empty");
+    }
+    return unlink(tail);
+  }
+
+  void clear() {
+    Node<T>* current = head;
+    while (current != nullptr) {
+      Node<T>* next = current->getNext();
+      deleteNode(current);
+      current = next;
+    }
+    head = nullptr;
+    tail = nullptr;
+    size = 0;
+    cursor = nullptr;
+  }
+
+  Node<T>* getHead() const { return head; }
+  Node<T>* getTail() const { return tail; }
+  int getLength() const { return size; }
+  bool isEmpty() const { return head == nullptr; }
+
+  std::string toString() const {
+    std::ostringstream oss;
+    for (const_iterator value = begin(); value != end(); ++value) {
+      if (value != begin()) {
+        oss << ", ";
+      }
+      oss << *value;
+    }
+    return oss.str();
+  }
+
+  T get(int index) const {
+    if (index < 0 || index >= size) {
+      throw std::out_of_range("Index out of range");
+    }
+    return nodeAt(index)->getValue();
+  }
+
+  void deleteFront() { removeFront(); }
+  void deleteBack() { removeEnd(); }
+
+  void addAt(T value, int index) {
+    if (index < 0 || index > size) {
+      throw std::out_of_range("Index out of range");
+    }
+
+    if (index == 0) {
+      addFront(value);
+      return;
+    }
+
+    if (index == size) {
+      addBack(value);
+      return;
+    }
+
+    Node<T>* next = nodeAt(index);
+    Node<T>* added = newNode(value);
+    added->setPrev(next->getPrev());
+    added->setNext(next);
+    next->getPrev()->setNext(added);
+    next->setPrev(added);
+    size++;
+    cursor = nullptr;
+  }
+
+  void deleteAt(int index) {
+    if (index < 0 || index >= size) {
+      throw std::out_of_range("Index out of range");
+    }
+    unlink(nodeAt(index));
+  }
+
+  // Each value followed by its coloured symbol, for types that have one
+  std::string enhancedPrint() const {
+    std::ostringstream oss;
+    for (const_iterator value = begin(); value != end(); ++value) {
+      if (value != begin()) {
+        oss << ", ";
+      }
+      oss << *value << value->enhancedPrint();
+    }
+    return oss.str();
+  }
+
+  NodePool<T>* getPool() const { return pool; }
 
  private:
-  Node* head;
-  Node* tail;
+  NodePool<T>* pool;
+  Node<T>* head;
+  Node<T>* tail;
   int size;
+
+  // The node the last indexed lookup reached, null when an edit may have moved it
+  mutable Node<T>* cursor;
+  mutable int cursorIndex;
+
+  // Start from whichever of the head, tail or cursor is nearest the index
+  Node<T>* nodeAt(int index) const {
+    Node<T>* current = head;
+    int position = 0;
+    if (size - 1 - index < index) {
+      current = tail;
+      position = size - 1;
+    }
+    if (cursor != nullptr && std::abs(cursorIndex - index) < std::abs(position - index)) {
+      current = cursor;
+      position = cursorIndex;
+    }
+    for (; position < index; ++position) {
+      current = current->getNext();
+    }
+    for (; position > index; --position) {
+      current = current->getPrev();
+    }
+    cursor = current;
+    cursorIndex = index;
+    return current;
+  }
+
+  T unlink(Node<T>* node) {
+    if (node->getPrev() == nullptr) {
+      head = node->getNext();
+    } else {
+      node->getPrev()->setNext(node->getNext());
+    }
+    if (node->getNext() == nullptr) {
+      tail = node->getPrev();
+    } else {
+      node->getNext()->setPrev(node->getPrev());
+    }
+
+    T removed = node->getValue();
+    deleteNode(node);
+    size--;
+    cursor = nullptr;
+    return removed;
+  }
+
+  void take(LinkedList& other) {
+    head = other.head;
+    tail = other.tail;
+    size = other.size;
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+    other.cursor = nullptr;
+  }
+
+  Node<T>* newNode(T value) {
+    return pool != nullptr ? pool->allocate(value) : new Node<T>(value);
+  }
+
+  void deleteNode(Node<T>* node) {
+    if (pool != nullptr) {
+      pool->release(node);
+    } else {
+      delete node;
+    }
+  }
 };
 
 #endif // ASSIGN2_LINKEDLIST_H
@@ -0,0 +1,89 @@
+#include "MappedFile.h"
+#include <fstream>
+#include <iterator>
+
+#if defined(_WIN32)
+#define MAPPED_FILE_READS
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : data(nullptr), size(0), mapped(false) {
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifndef MAPPED_FILE_READS
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    bool opened = fstat(fd, &info) == 0;
+    if (opened && info.st_size >= MIN_MAPPED_FILE_SIZE) {
+        void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            opened = false;
+        } else {
+            data = static_cast<const unsigned char*>(view);
+            size = info.st_size;
+            mapped = true;
+        }
+    } else if (opened && info.st_size > 0) {
+        buffer.resize(info.st_size);
+        std::size_t total = 0;
+        while (opened && total < buffer.size()) {
+            ssize_t count = ::read(fd, buffer.data() + total, buffer.size() - total);
+            opened = count > 0;
+            total += opened ? count : 0;
+        }
+        data = buffer.data();
+        size = buffer.size();
+    }
+    // A mapping stays valid once the file is closed
+    ::close(fd);
+    if (!opened) {
+        close();
+    }
+    return opened;
+}
+
+void MappedFile::close() {
+    if (mapped) {
+        munmap(const_cast<unsigned char*>(data), size);
+    }
+    buffer.clear();
+    data = nullptr;
+    size = 0;
+    mapped = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+    std::ifstream inFile(filename, std::ios::binary);
+    if (!inFile.is_open()) {
+        return false;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+    data = buffer.empty() ? nullptr : buffer.data();
+    size = buffer.size();
+    return true;
+}
+
+void MappedFile::close() {
+    buffer.clear();
+    data = nullptr;
+    size = 0;
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef ASSIGN2_MAPPEDFILE_H
+#define ASSIGN2_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Files smaller than this are read rather than mapped, setting up and tearing
+// down a mapping costs more than copying a few pages
+#define MIN_MAPPED_FILE_SIZE (64 * 1024)
+
+/*
+ * A whole file mapped read only into memory, so it can be parsed in place
+ * without copying it into strings first. Small files, and every file where
+ * mapping is not available, are read into a buffer and used the same way.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    // Map a file, false if it can not be opened. An empty file opens with no data.
+    bool open(const std::string& filename);
+    void close();
+
+    const unsigned char* getData() const { return data; }
+    std::size_t getSize() const { return size; }
+
+private:
+    const unsigned char* data;
+    std::size_t size;
+    bool mapped;
+    std::vector<unsigned char> buffer;
+};
+
+#endif // ASSIGN2_MAPPEDFILE_H
@@ -0,0 +1,294 @@
+#include "MoveGenerator.h"
+#include <algorithm>
+#include "Rules.h"
+#include "TileCodes.h"
+
+/*
+ * Generate every legal move for a hand
+ * Each move is built from its first frontier cell (anchor) along a row or
+ * column. It may start in the empty cells just before the anchor as long as
+ * those touch no tile, which makes every move come from exactly one anchor.
+ */
+void MoveGenerator::generateMoves(const GameBoard& board, const std::vector<TileCode>& hand, std::vector<Move>& moves) {
+    generateMoves(board, hand, getAnchors(board), moves);
+}
+
+std::vector<BoardCell> MoveGenerator::getAnchors(const GameBoard& board) {
+    // An empty board has no frontier, so the first move is built through its centre
+    if (board.isEmpty()) {
+        return {{board.getRows() / 2, board.getCols() / 2}};
+    }
+    return board.getFrontier();
+}
+
+void MoveGenerator::generateMoves(const GameBoard& board, const std::vector<TileCode>& hand,
+                                  const std::vector<BoardCell>& anchors, std::vector<Move>& moves) {
+    Search search;
+    search.board = &board;
+    search.moves = &moves;
+
+    // Group identical tiles so each is only tried once per cell
+    search.distinctTiles = 0;
+    int handSize = 0;
+    TileMask handMask = 0;
+    for (TileCode tile : hand) {
+        if (handSize == MAX_MOVE_TILES) {
+            break;
+        }
+        handSize++;
+        handMask |= Tile::tileBit(tile);
+        int i = 0;
+        while (i < search.distinctTiles && search.tiles[i] != tile) {
+            ++i;
+        }
+        if (i == search.distinctTiles) {
+            search.tiles[i] = tile;
+            search.counts[i] = 0;
+            search.distinctTiles++;
+        }
+        search.counts[i]++;
+    }
+    if (handSize == 0) {
+        return;
+    }
+
+    const int directions[2][2] = {{0, 1}, {1, 0}};
+    for (int direction = 0; direction < 2; ++direction) {
+        search.rowStep = directions[direction][0];
+        search.colStep = directions[direction][1];
+        // A single tile lies on both a row and a column, only keep it once
+        search.recordSingleTiles = direction == 0;
+
+        for (const BoardCell& anchor : anchors) {
+            // Every move from an anchor puts a tile on it, so skip anchors none of the hand fits
+            if (!board.isEmpty() && (board.getLegalTiles(anchor.row, anchor.col) & handMask) == 0) {
+                continue;
+            }
+            search.anchorRow = anchor.row;
+            search.anchorCol = anchor.col;
+            search.move.count = 0;
+
+            // Tiles already on the board just before the anchor start the line
+            LineRun before = {0, 0, 0};
+            int row = anchor.row - search.rowStep;
+            int col = anchor.col - search.colStep;
+            if (board.getTileCode(row, col) != EMPTY_TILE) {
+                before = search.rowStep == 0 ? board.getRowRun(row, col) : board.getColumnRun(row, col);
+            }
+            extend(search, anchor.row, anchor.col, before, 0);
+
+            // Start the move earlier in empty cells that do not touch any tile
+            for (int lead = 1; lead < handSize; ++lead) {
+                if (row < 0 || col < 0 || board.getTileCode(row, col) != EMPTY_TILE || board.isFrontier(row, col)) {
+                    break;
+                }
+                LineRun empty = {0, 0, 0};
+                extend(search, row, col, empty, 0);
+                row -= search.rowStep;
+                col -= search.colStep;
+            }
+        }
+    }
+}
+
+void MoveGenerator::extend(Search& search, int row, int col, const LineRun& line, int crossScore) {
+    const GameBoard& board = *search.board;
+    int rowStep = search.rowStep;
+    int colStep = search.colStep;
+
+    // Tiles already on the board straight after this cell join the line too
+    LineRun after = {0, 0, 0};
+    if (board.getTileCode(row + rowStep, col + colStep) != EMPTY_TILE) {
+        after = rowStep == 0 ? board.getRowRun(row, col + 1) : board.getColumnRun(row + 1, col);
+    }
+    LineRun around = joinRuns(line, after);
+    const LineRun& cross = crossRun(board, row, col, rowStep);
+    TileMask crossLegal = Rules::lineLegalTiles(cross);
+
+    bool coversAnchor = (row - search.anchorRow) * rowStep + (col - search.anchorCol) * colStep >= 0;
+    int nextRow = row + (after.length + 1) * rowStep;
+    int nextCol = col + (after.length + 1) * colStep;
+    bool canContinue = search.move.count + 1 < MAX_MOVE_TILES && nextRow < board.getRows() && nextCol < board.getCols();
+
+    for (int i = 0; i < search.distinctTiles; ++i) {
+        TileCode tile = search.tiles[i];
+        TileMask bit = Tile::tileBit(tile);
+        if (search.counts[i] == 0 || (crossLegal & bit) == 0) {
+            continue;
+        }
+
+        LineRun joined = joinRuns(around, tileRun(tile));
+        bool extendable = Rules::isValidLine(joined);
+        // A lone tile follows the same rule as Rules::validateMove
+        bool legal = search.move.count == 0 ? (Rules::lineLegalTiles(around) & bit) != 0 : extendable;
+        if (!legal) {
+            continue;
+        }
+
+        int tileCrossScore = crossScore + Rules::scoreLine(joinRuns(cross, tileRun(tile)));
+        search.move.placements[search.move.count] = {row, col, tile};
+        search.move.count++;
+        search.counts[i]--;
+
+        if (coversAnchor && (search.move.count > 1 || search.recordSingleTiles)) {
+            Move move = search.move;
+            move.score = std::max(1, Rules::scoreLine(joined) + tileCrossScore);
+            search.moves->push_back(move);
+        }
+        if (extendable && canContinue) {
+            extend(search, nextRow, nextCol, joined, tileCrossScore);
+        }
+
+        search.counts[i]++;
+        search.move.count--;
+    }
+}
+
+/*
+ * Score a move entered by a player
+ * The tiles must share a row or column, fill a gap free stretch of it
+ * (tiles already on the board may sit between them) and touch a tile on
+ * the board unless it is the first move.
+ */
+int MoveGenerator::scoreMove(const GameBoard& board, const Move& move) {
+    if (move.count < 1 || move.count > MAX_MOVE_TILES) {
+        return -1;
+    }
+
+    bool sameRow = true;
+    bool sameCol = true;
+    for (int i = 1; i < move.count; ++i) {
+        sameRow = sameRow && move.placements[i].row == move.placements[0].row;
+        sameCol = sameCol && move.placements[i].col == move.placements[0].col;
+    }
+    if (!sameRow && !sameCol) {
+        return -1;
+    }
+    int rowStep = sameRow ? 0 : 1;
+    int colStep = sameRow ? 1 : 0;
+
+    // Order the placements along their line
+    Move ordered = move;
+    std::sort(ordered.placements, ordered.placements + ordered.count, [](const Placement& a, const Placement& b) {
+        return a.row != b.row ? a.row < b.row : a.col < b.col;
+    });
+
+    bool touchesTile = board.isEmpty();
+    int crossScore = 0;
+    for (int i = 0; i < ordered.count; ++i) {
+        const Placement& placement = ordered.placements[i];
+        if (placement.row < 0 || placement.row >= board.getRows() || placement.col < 0 || placement.col >= board.getCols() ||
+            board.getTileCode(placement.row, placement.col) != EMPTY_TILE) {
+            return -1;
+        }
+        if (i > 0 && placement.row == ordered.placements[i - 1].row && placement.col == ordered.placements[i - 1].col) {
+            return -1;
+        }
+        const LineRun& cross = crossRun(board, placement.row, placement.col, rowStep);
+        if ((Rules::lineLegalTiles(cross) & Tile::tileBit(placement.tile)) == 0) {
+            return -1;
+        }
+        crossScore += Rules::scoreLine(joinRuns(cross, tileRun(placement.tile)));
+        touchesTile = touchesTile || board.isFrontier(placement.row, placement.col);
+    }
+    if (!touchesTile) {
+        return -1;
+    }
+
+    // Walk the whole line, from the tiles before the first placement to the tiles after the last
+    const Placement& first = ordered.placements[0];
+    LineRun line = {0, 0, 0};
+    if (board.getTileCode(first.row - rowStep, first.col - colStep) != EMPTY_TILE) {
+        line = rowStep == 0 ? board.getRowRun(first.row, first.col - 1) : board.getColumnRun(first.row - 1, first.col);
+    }
+    int next = 0;
+    for (int row = first.row, col = first.col; ; row += rowStep, col += colStep) {
+        if (next < ordered.count && ordered.placements[next].row == row && ordered.placements[next].col == col) {
+            line = joinRuns(line, tileRun(ordered.placements[next].tile));
+            next++;
+        } else if (board.getTileCode(row, col) != EMPTY_TILE) {
+            line = joinRuns(line, tileRun(board.getTileCode(row, col)));
+        } else {
+            break;
+        }
+    }
+    if (next < ordered.count) {
+        return -1;
+    }
+
+    bool legal;
+    if (ordered.count == 1) {
+        legal = board.isEmpty() || (board.getLegalTiles(first.row, first.col) & Tile::tileBit(first.tile)) != 0;
+    } else {
+        legal = Rules::isValidLine(line);
+    }
+    if (!legal) {
+        return -1;
+    }
+    return std::max(1, Rules::scoreLine(line) + crossScore);
+}
+
+bool MoveGenerator::isBetterMove(const Move& move, const Move& other) {
+    if (move.score != other.score) {
+        return move.score > other.score;
+    }
+    for (int i = 0; i < move.count && i < other.count; ++i) {
+        const Placement& a = move.placements[i];
+        const Placement& b = other.placements[i];
+        if (a.row != b.row) {
+            return a.row < b.row;
+        }
+        if (a.col != b.col) {
+            return a.col < b.col;
+        }
+        if (a.tile != b.tile) {
+            return a.tile < b.tile;
+        }
+    }
+    return move.count < other.count;
+}
+
+void MoveGenerator::applyMove(GameBoard* board, const Move& move) {
+    for (int i = 0; i < move.count; ++i) {
+        const Placement& placement = move.placements[i];
+        board->placeTile(placement.row, placement.col, Tile::fromCode(placement.tile));
+    }
+}
+
+void MoveGenerator::undoMove(GameBoard* board, const Move& move) {
+    for (int i = move.count - 1; i >= 0; --i) {
+        board->placeTile(move.placements[i].row, move.placements[i].col, Tile());
+    }
+}
+
+std::string MoveGenerator::describeMove(const Move& move) {
+    std::string description;
+    for (int i = 0; i < move.count; ++i) {
+        const Placement& placement = move.placements[i];
+        if (i > 0) {
+            description += ", ";
+        }
+        description += Tile::fromCode(placement.tile).print() + " at " + char('A' + placement.row) + std::to_string(placement.col);
+    }
+    return description;
+}
+
+const LineRun& MoveGenerator::crossRun(const GameBoard& board, int row, int col, int rowStep) {
+    return rowStep == 0 ? board.getColumnRun(row, col) : board.getRowRun(row, col);
+}
+
+LineRun MoveGenerator::joinRuns(const LineRun& run, const LineRun& other) {
+    LineRun joined;
+    joined.length = run.length + other.length;
+    joined.colours = run.colours | other.colours;
+    joined.shapes = run.shapes | other.shapes;
+    return joined;
+}
+
+LineRun MoveGenerator::tileRun(TileCode tile) {
+    LineRun run;
+    run.length = 1;
+    run.colours = Tile::colourBit(tile);
+    run.shapes = Tile::shapeBit(tile);
+    return run;
+}
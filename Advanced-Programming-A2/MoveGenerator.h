@@ -0,0 +1,84 @@
+#ifndef ASSIGN2_MOVEGENERATOR_H
+#define ASSIGN2_MOVEGENERATOR_H
+
+#include <string>
+#include <vector>
+#include "GameBoard.h"
+
+// Most tiles a player can place in one turn
+#define MAX_MOVE_TILES 6
+
+// A single tile placed as part of a move
+struct Placement {
+    int row;
+    int col;
+    TileCode tile;
+};
+
+// Every tile placed in one turn, all in one line
+struct Move {
+    Placement placements[MAX_MOVE_TILES];
+    int count;
+    int score;
+};
+
+class MoveGenerator {
+public:
+    // Append every legal move for a hand to moves with its score. Moves are built outward from
+    // the board's frontier cells and a partial line is abandoned as soon as it breaks the colour
+    // and shape rule. A move of one tile is legal exactly when Rules::validateMove allows it,
+    // longer moves also need their shared line to have no repeated tile.
+    static void generateMoves(const GameBoard& board, const std::vector<TileCode>& hand, std::vector<Move>& moves);
+
+    // Cells every move is built from, the frontier or the centre of an empty board
+    static std::vector<BoardCell> getAnchors(const GameBoard& board);
+
+    // Append only the moves built from the given anchors. Splitting the anchors between calls
+    // splits the moves between them without repeating any, so the calls can run side by side.
+    static void generateMoves(const GameBoard& board, const std::vector<TileCode>& hand,
+                              const std::vector<BoardCell>& anchors, std::vector<Move>& moves);
+
+    // Score a move made up by a player, or -1 if it is not legal
+    static int scoreMove(const GameBoard& board, const Move& move);
+
+    // Check if a move should be preferred over another, higher scores first and then the
+    // earliest placements so the choice never depends on the order moves were generated in
+    static bool isBetterMove(const Move& move, const Move& other);
+
+    // Place every tile of a move on the board
+    static void applyMove(GameBoard* board, const Move& move);
+
+    // Take the tiles of a move back off the board
+    static void undoMove(GameBoard* board, const Move& move);
+
+    // Describe a move as "<tile> at <position>" for each placement
+    static std::string describeMove(const Move& move);
+
+private:
+    // Working state for building the moves through one anchor in one direction
+    struct Search {
+        const GameBoard* board;
+        std::vector<Move>* moves;
+        int rowStep;
+        int colStep;
+        int anchorRow;
+        int anchorCol;
+        bool recordSingleTiles;
+        TileCode tiles[MAX_MOVE_TILES];
+        int counts[MAX_MOVE_TILES];
+        int distinctTiles;
+        Move move;
+    };
+
+    // Try each hand tile in the empty cell at row, col and keep extending along the line
+    static void extend(Search& search, int row, int col, const LineRun& line, int crossScore);
+
+    // Run through a cell across the direction of the main line
+    static const LineRun& crossRun(const GameBoard& board, int row, int col, int rowStep);
+
+    // Add a tile, or a run of tiles, to a line
+    static LineRun joinRuns(const LineRun& run, const LineRun& other);
+    static LineRun tileRun(TileCode tile);
+};
+
+#endif // ASSIGN2_MOVEGENERATOR_H
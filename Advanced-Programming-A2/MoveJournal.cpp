@@ -0,0 +1,224 @@
+#include "MoveJournal.h"
+#include <algorithm>
+#include <cstring>
+#include "MappedFile.h"
+#include "SaveFormat.h"
+#include "TileCodes.h"
+#include "TileSet.h"
+
+MoveJournal::MoveJournal()
+    : players{nullptr, nullptr}, turn(0), scores{0, 0}, bagLength(0), bagDraws(0), bagSeed(0), boardTiles(0) {
+    turnMove.count = 0;
+}
+
+bool MoveJournal::start(const std::string& saveFile, Player* first, Player* second) {
+    stop();
+    MappedFile save;
+    if (!save.open(saveFile)) {
+        return false;
+    }
+
+    JournalHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, JOURNAL_MAGIC, JOURNAL_MAGIC_LENGTH);
+    header.version = JOURNAL_VERSION;
+    header.recordSize = sizeof(JournalRecord);
+    header.saveChecksum = saveChecksum(save.getData(), save.getSize());
+
+    journal.open(journalFile(saveFile), std::ios::binary | std::ios::trunc);
+    journal.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    journal.flush();
+    if (!journal) {
+        stop();
+        return false;
+    }
+    this->saveFile = saveFile;
+    players[0] = first;
+    players[1] = second;
+    turn = 0;
+    return true;
+}
+
+void MoveJournal::stop() {
+    if (journal.is_open()) {
+        journal.close();
+    }
+    journal.clear();
+    saveFile.clear();
+}
+
+void MoveJournal::beginTurn(TileBag* tileBag, GameBoard* board) {
+    if (!isStarted()) {
+        return;
+    }
+    for (int i = 0; i < 2; ++i) {
+        hands[i] = *players[i]->getHand();
+        scores[i] = players[i]->getScore();
+    }
+    bagLength = tileBag->getLength();
+    bagDraws = tileBag->getDrawCount();
+    bagSeed = tileBag->getSeed();
+    boardTiles = board->getTileCount();
+    turnMove.count = 0;
+}
+
+void MoveJournal::recordMove(const Move& move) {
+    for (int i = 0; i < move.count && turnMove.count < MAX_MOVE_TILES; ++i) {
+        turnMove.placements[turnMove.count++] = move.placements[i];
+    }
+}
+
+bool MoveJournal::endTurn(Player* player, TileBag* tileBag, GameBoard* board) {
+    if (!isStarted()) {
+        return true;
+    }
+    JournalRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.player = player == players[1] ? 1 : 0;
+
+    // Only the player whose turn it was may have changed
+    Hand* otherHand = players[1 - record.player]->getHand();
+    const Hand& otherBefore = hands[1 - record.player];
+    if (players[1 - record.player]->getScore() != scores[1 - record.player] ||
+        otherHand->getLength() != otherBefore.getLength() ||
+        !std::equal(otherHand->begin(), otherHand->end(), otherBefore.begin())) {
+        return false;
+    }
+
+    // Every tile the board gained has to have come from a recorded move
+    if (board->getTileCount() - boardTiles != turnMove.count || board->getRows() > 256 || board->getCols() > 256) {
+        return false;
+    }
+    for (int i = 0; i < turnMove.count; ++i) {
+        const Placement& placement = turnMove.placements[i];
+        if (board->getTileCode(placement.row, placement.col) != placement.tile) {
+            return false;
+        }
+        record.tiles[i] = placement.tile;
+        record.rows[i] = placement.row;
+        record.cols[i] = placement.col;
+    }
+    record.placed = turnMove.count;
+
+    // Draws take the old tiles from the front before any returned to the back, so draws beyond
+    // the old bag took back tiles returned this turn, and whatever returned tiles are left are
+    // at the back of the bag
+    std::uint64_t draws = tileBag->getDrawCount() - bagDraws;
+    int drawn = std::min<std::uint64_t>(draws, bagLength);
+    int lengthAfter = tileBag->getLength();
+    int returned = lengthAfter - (bagLength - drawn);
+    if (drawn > 255 || returned < 0 || returned > JOURNAL_TURN_TILES || tileBag->getSeed() != bagSeed) {
+        return false;
+    }
+    record.drawn = drawn;
+    record.returned = returned;
+    for (int i = 0; i < returned; ++i) {
+        record.returnedTiles[i] = tileBag->get(lengthAfter - returned + i).getCode();
+    }
+
+    Hand* hand = player->getHand();
+    record.handLength = hand->getLength();
+    for (int i = 0; i < hand->getLength(); ++i) {
+        record.hand[i] = hand->get(i).getCode();
+    }
+    record.score = player->getScore();
+    record.randomState = tileBag->getRandomState();
+    record.turn = ++turn;
+    record.checksum = recordChecksum(record);
+
+    journal.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    journal.flush();
+    return journal.good();
+}
+
+int MoveJournal::replay(const std::string& saveFile, std::uint64_t saveChecksum, Player* first, Player* second,
+                        TileBag* tileBag, GameBoard* board, Player* currentPlayer) {
+    std::vector<JournalRecord> records;
+    readRecords(saveFile, saveChecksum, records);
+    Player* players[2] = {first, second};
+    int applied = 0;
+    int lastPlayer = 1;
+    for (const JournalRecord& record : records) {
+        if (!applyRecord(record, players, tileBag, board)) {
+            break;
+        }
+        lastPlayer = record.player;
+        applied++;
+    }
+    if (applied > 0) {
+        currentPlayer->setName(players[1 - lastPlayer]->getName());
+    }
+    return applied;
+}
+
+bool MoveJournal::readRecords(const std::string& saveFile, std::uint64_t saveChecksum, std::vector<JournalRecord>& records) {
+    records.clear();
+    MappedFile file;
+    if (!file.open(journalFile(saveFile)) || file.getSize() < sizeof(JournalHeader)) {
+        return false;
+    }
+    JournalHeader header;
+    std::memcpy(&header, file.getData(), sizeof(header));
+    if (std::memcmp(header.magic, JOURNAL_MAGIC, JOURNAL_MAGIC_LENGTH) != 0 || header.version != JOURNAL_VERSION ||
+        header.recordSize != sizeof(JournalRecord) || header.saveChecksum != saveChecksum) {
+        return false;
+    }
+
+    // A record cut short by a crash is left off the count
+    std::size_t count = (file.getSize() - sizeof(JournalHeader)) / sizeof(JournalRecord);
+    records.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        JournalRecord record;
+        std::memcpy(&record, file.getData() + sizeof(JournalHeader) + i * sizeof(JournalRecord), sizeof(record));
+        if (record.checksum != recordChecksum(record) || record.turn != i + 1) {
+            break;
+        }
+        records.push_back(record);
+    }
+    return true;
+}
+
+std::uint64_t MoveJournal::recordChecksum(JournalRecord record) {
+    record.checksum = 0;
+    return saveChecksum(reinterpret_cast<const unsigned char*>(&record), sizeof(record));
+}
+
+bool MoveJournal::applyRecord(const JournalRecord& record, Player* players[2], TileBag* tileBag, GameBoard* board) {
+    bool valid = record.player <= 1 && record.placed <= JOURNAL_TURN_TILES && record.returned <= JOURNAL_TURN_TILES &&
+                 record.handLength <= MAX_HAND_SIZE && record.drawn <= tileBag->getLength() &&
+                 tileBag->getLength() - record.drawn + record.returned <= MAX_BAG_TILES;
+    for (int i = 0; valid && i < record.placed; ++i) {
+        valid = TileSet::contains(Tile::fromCode(record.tiles[i])) && record.rows[i] < board->getRows() &&
+                record.cols[i] < board->getCols() && board->getTileCode(record.rows[i], record.cols[i]) == EMPTY_TILE;
+        for (int j = 0; valid && j < i; ++j) {
+            valid = record.rows[i] != record.rows[j] || record.cols[i] != record.cols[j];
+        }
+    }
+    for (int i = 0; valid && i < record.returned; ++i) {
+        valid = TileSet::contains(Tile::fromCode(record.returnedTiles[i]));
+    }
+    for (int i = 0; valid && i < record.handLength; ++i) {
+        valid = TileSet::contains(Tile::fromCode(record.hand[i]));
+    }
+    if (!valid) {
+        return false;
+    }
+
+    Player* player = players[record.player];
+    for (int i = 0; i < record.placed; ++i) {
+        board->placeTile(record.rows[i], record.cols[i], Tile::fromCode(record.tiles[i]));
+    }
+    for (int i = 0; i < record.drawn; ++i) {
+        tileBag->drawTile();
+    }
+    for (int i = 0; i < record.returned; ++i) {
+        tileBag->addTile(Tile::fromCode(record.returnedTiles[i]));
+    }
+    tileBag->setRandomState(tileBag->getSeed(), record.randomState);
+    player->getHand()->clear();
+    for (int i = 0; i < record.handLength; ++i) {
+        player->addTileToHand(Tile::fromCode(record.hand[i]));
+    }
+    player->setScore(record.score);
+    return true;
+}
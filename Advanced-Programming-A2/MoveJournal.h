@@ -0,0 +1,131 @@
+#ifndef ASSIGN2_MOVEJOURNAL_H
+#define ASSIGN2_MOVEJOURNAL_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "GameBoard.h"
+#include "Hand.h"
+#include "MoveGenerator.h"
+#include "Player.h"
+#include "TileBag.h"
+
+/*
+ * Layout of a journal file, kept beside a save and named after it with
+ * JOURNAL_EXTENSION added. A JournalHeader naming the save it follows is
+ * followed by one JournalRecord per turn played since that save.
+ * Numbers are stored in the byte order of the machine that wrote them.
+ */
+
+#define JOURNAL_MAGIC "QWKJ"
+#define JOURNAL_MAGIC_LENGTH 4
+#define JOURNAL_VERSION 1
+#define JOURNAL_EXTENSION ".journal"
+
+// Most tiles a turn can place, draw or return and still fit in one record
+#define JOURNAL_TURN_TILES 6
+
+struct JournalHeader {
+    char magic[JOURNAL_MAGIC_LENGTH];
+    std::uint16_t version;
+    std::uint16_t recordSize;
+    // saveChecksum of the whole save file, the journal is ignored if the save has changed since
+    std::uint64_t saveChecksum;
+};
+
+/*
+ * One turn as the changes it made. Replaying a record places its tiles,
+ * takes drawn tiles from the front of the bag and then puts returned tiles
+ * on the back, and sets the player's hand and score to what they were after
+ * the turn. A turn that changed nothing is a pass.
+ */
+struct JournalRecord {
+    // Turns count from 1 after the save
+    std::uint32_t turn;
+    std::int32_t score;
+    std::uint64_t randomState;
+    // 0 for the first player in the save, 1 for the second
+    std::uint8_t player;
+    std::uint8_t placed;
+    std::uint8_t drawn;
+    std::uint8_t returned;
+    std::uint8_t handLength;
+    std::uint8_t reserved[3];
+    std::uint8_t tiles[JOURNAL_TURN_TILES];
+    std::uint8_t rows[JOURNAL_TURN_TILES];
+    std::uint8_t cols[JOURNAL_TURN_TILES];
+    std::uint8_t returnedTiles[JOURNAL_TURN_TILES];
+    std::uint8_t hand[MAX_HAND_SIZE];
+    std::uint8_t padding[2];
+    // saveChecksum of the record with this field set to 0, a torn or damaged record does not match
+    std::uint64_t checksum;
+};
+
+static_assert(sizeof(JournalHeader) == 16, "The journal header has no padding between fields");
+static_assert(sizeof(JournalRecord) == 64, "Journal records are one cache line with no padding between fields");
+static_assert(std::is_trivially_copyable<JournalRecord>::value, "Journal records are copied as plain bytes");
+
+/*
+ * Records every turn of a game after its last save, so a game that stops
+ * without saving can be loaded again up to its last complete turn. Each turn
+ * costs one record appended to the journal rather than rewriting the save.
+ */
+class MoveJournal {
+public:
+    MoveJournal();
+
+    MoveJournal(const MoveJournal& other) = delete;
+    MoveJournal& operator=(const MoveJournal& other) = delete;
+
+    // Start a new, empty journal for a save that has just been written, with the players
+    // in the order the save lists them. False if the save or journal can not be opened.
+    bool start(const std::string& saveFile, Player* first, Player* second);
+    void stop();
+    bool isStarted() const { return journal.is_open(); }
+
+    // Check if the journal follows a particular save file
+    bool isFor(const std::string& saveFile) const { return isStarted() && saveFile == this->saveFile; }
+
+    // Note the game before a turn, then append what the turn changed. The tiles placed are the
+    // ones passed to recordMove by whatever played them, and the tiles drawn are counted by the
+    // bag, so neither the board nor the bag is searched. False if the turn can not be written
+    // as a record, in which case the save should be written again and the journal started afresh.
+    void beginTurn(TileBag* tileBag, GameBoard* board);
+    void recordMove(const Move& move);
+    bool endTurn(Player* player, TileBag* tileBag, GameBoard* board);
+
+    // Apply the journal of a save that has just been loaded, with the players in the order
+    // the save lists them. Stops at the first record that is torn, damaged or does not fit
+    // the game, and returns the number of turns applied.
+    static int replay(const std::string& saveFile, std::uint64_t saveChecksum, Player* first, Player* second,
+                      TileBag* tileBag, GameBoard* board, Player* currentPlayer);
+
+    // Read the whole records of the journal of a save, up to the first one that is damaged or
+    // out of order, without checking them against a game. False if there is no journal for the save.
+    static bool readRecords(const std::string& saveFile, std::uint64_t saveChecksum, std::vector<JournalRecord>& records);
+
+    static std::string journalFile(const std::string& saveFile) { return saveFile + JOURNAL_EXTENSION; }
+
+private:
+    std::ofstream journal;
+    std::string saveFile;
+    Player* players[2];
+    std::uint32_t turn;
+
+    // The game as it was before the current turn, and the tiles placed in it so far
+    Hand hands[2];
+    int scores[2];
+    int bagLength;
+    std::uint64_t bagDraws;
+    std::uint64_t bagSeed;
+    int boardTiles;
+    Move turnMove;
+
+    static std::uint64_t recordChecksum(JournalRecord record);
+    // Check a record fits the game before changing anything, then apply it
+    static bool applyRecord(const JournalRecord& record, Player* players[2], TileBag* tileBag, GameBoard* board);
+};
+
+#endif // ASSIGN2_MOVEJOURNAL_H
@@ -1,34 +1,25 @@
 #ifndef ASSIGN2_NODE_H
 #define ASSIGN2_NODE_H
 
-#include "Tile.h"
-
+// One entry of a LinkedList, linked both ways
+template <typename T>
 class Node {
 public:
-    Node(Tile* tile, Node* next = nullptr);
-    ~Node();
-
-    // Copy constructor
-    Node(const Node& other);
-
-    // Copy assignment operator
-    Node& operator=(const Node& other);
-
-    // Move constructor
-    Node(Node&& other);
-
-    // Move assignment operator
-    Node& operator=(Node&& other);
+    Node(T value, Node* next = nullptr, Node* prev = nullptr) : value(value), next(next), prev(prev) {}
 
-    Tile* getTile() const;
-    Node* getNext() const;
+    T getValue() const { return value; }
+    T& getValue() { return value; }
+    Node* getNext() const { return next; }
+    Node* getPrev() const { return prev; }
 
-    void setTile(Tile* tile);
-    void setNext(Node* next);
+    void setValue(T value) { this->value = value; }
+    void setNext(Node* next) { this->next = next; }
+    void setPrev(Node* prev) { this->prev = prev; }
 
 private:
-    Tile* tile;
+    T value;
     Node* next;
+    Node* prev;
 };
 
 #endif // ASSIGN2_NODE_H
@@ -0,0 +1,64 @@
+#ifndef ASSIGN2_NODEPOOL_H
+#define ASSIGN2_NODEPOOL_H
+
+#include <vector>
+#include "Node.h"
+
+// Nodes taken from the heap at a time when the pool runs dry
+#define NODE_POOL_BLOCK_SIZE 64
+
+/*
+ * Hands out list nodes from blocks it owns and keeps released nodes on a free
+ * list, so a game that reuses its nodes stops calling the heap. One pool is
+ * meant for one game and is not safe to share between threads.
+ */
+template <typename T>
+class NodePool {
+public:
+    NodePool() : freeList(nullptr), allocations(0), heapAllocations(0) {}
+
+    NodePool(const NodePool& other) = delete;
+    NodePool& operator=(const NodePool& other) = delete;
+
+    Node<T>* allocate(T value) {
+        if (freeList == nullptr) {
+            // Chain a new block onto the free list, the blocks never move once made
+            blocks.emplace_back(NODE_POOL_BLOCK_SIZE, Node<T>(T()));
+            for (Node<T>& node : blocks.back()) {
+                node.setNext(freeList);
+                freeList = &node;
+            }
+            heapAllocations++;
+        }
+
+        Node<T>* node = freeList;
+        freeList = node->getNext();
+        node->setValue(value);
+        node->setNext(nullptr);
+        node->setPrev(nullptr);
+        allocations++;
+        return node;
+    }
+
+    // Give a node back for reuse, it must have come from this pool
+    void release(Node<T>* node) {
+        node->setNext(freeList);
+        freeList = node;
+    }
+
+    // Nodes handed out and blocks taken from the heap since the last reset
+    long getAllocations() const { return allocations; }
+    long getHeapAllocations() const { return heapAllocations; }
+    void resetCounters() {
+        allocations = 0;
+        heapAllocations = 0;
+    }
+
+private:
+    std::vector<std::vector<Node<T>>> blocks;
+    Node<T>* freeList;
+    long allocations;
+    long heapAllocations;
+};
+
+#endif // ASSIGN2_NODEPOOL_H
@@ -6,24 +6,10 @@
 Player::Player(const std::string& name) : name(name), score(0) {}
 
 // Destructor
-Player::~Player() {
-    // Cleanup the linked list of tiles in hand
-    Tile* tile;
-    while ((tile = hand.removeFront()) != nullptr) {
-        delete tile;
-    }
-}
+Player::~Player() {}
 
-// Copy constructor
-Player::Player(const Player& other) : name(other.name), score(other.score) {
-  // Copy the LinkedList (deep copy of hand)
-  Node* current = other.hand.getHead();
-  while (current != nullptr) {
-    // Deep copy Tile
-    addTileToHand(new Tile(*current->getTile()));  
-    current = current->getNext();
-  }
-}
+// Copy constructor, tiles are values so copying the hand copies them
+Player::Player(const Player& other) : name(other.name), score(other.score), hand(other.hand) {}
 
 // Move constructor
 Player::Player(Player&& other)
@@ -37,19 +23,9 @@ Player::Player(Player&& other)
 // Copy assignment operator
 Player& Player::operator=(const Player& other) {
   if (this != &other) {
-    // Clean up existing resources
-    clear();  
-
     name = other.name;
     score = other.score;
-
-    // Copy the LinkedList (deep copy of hand)
-    Node* current = other.hand.getHead();
-    while (current != nullptr) {
-        // Deep copy Tile
-      addTileToHand(new Tile(*current->getTile()));  
-      current = current->getNext();
-    }
+    hand = other.hand;
   }
   return *this;
 }
@@ -57,9 +33,6 @@ Player& Player::operator=(const Player& other) {
 // Move assignment operator
 Player& Player::operator=(Player&& other) {
   if (this != &other) {
-    // Clean up existing resources
-    clear();  
-
     name = std::move(other.name);
     score = other.score;
     hand = std::move(other.hand);
@@ -70,15 +43,6 @@ Player& Player::operator=(Player&& other) {
   return *this;
 }
 
-// Implementation of the clear function
-void Player::clear() {
-  Tile* tile;
-  while ((tile = hand.removeFront()) != nullptr) {
-    // Remove and delete each Tile
-    delete tile;
-  }
-}
-
 // Getter for player name
 std::string Player::getName() const {
     return name;
@@ -100,45 +64,38 @@ void Player::setScore(int newScore) {
 }
 
 // Add a tile to the player's hand
-void Player::addTileToHand(Tile* tile) {
-    hand.addBack(tile);
+bool Player::addTileToHand(Tile tile) {
+    return hand.add(tile);
 }
 
 // Add quantity of tiles to player's hand
 void Player::drawQuantityTiles(TileBag* tileBag, int quantity) {
-    for (int i = 0; i < quantity; i++) {
-        Tile* newTile = tileBag->drawTile();
-        if (newTile != nullptr) {
-            hand.addBack(newTile);
+    for (int i = 0; i < quantity && !hand.isFull(); i++) {
+        Tile newTile = tileBag->drawTile();
+        if (!newTile.isEmpty()) {
+            hand.add(newTile);
         }
     }
 }
 
 // Remove a tile from the player's hand
-Tile* Player::removeTileFromHand(Tile* tile) {
-    Tile* removedTile = hand.remove(tile);
-    if (removedTile == nullptr) {
-        std::cout << "Error: Failed to remove tile from hand." << std::endl;
-    }
-    return removedTile;
+bool Player::removeTileFromHand(Tile tile) {
+    return hand.remove(tile);
 }
 
 // Getter for player's hand
-LinkedList* Player::getHand() {
+Hand* Player::getHand() {
     return &hand;
 }
 
 // Setter for player's hand (initializes hand with given tiles)
-void Player::setHand(const std::vector<Tile*>& tiles) {
+void Player::setHand(const std::vector<Tile>& tiles) {
     // Clear existing hand
-    Tile* tile;
-    while ((tile = hand.remove(nullptr)) != nullptr) {
-        delete tile;
-    }
+    hand.clear();
 
     // Add tiles to hand
-    for (Tile* tile : tiles) {
-        hand.addBack(tile);
+    for (Tile tile : tiles) {
+        hand.add(tile);
     }
 }
 
@@ -148,12 +105,10 @@ std::string Player::toString() const {
 }
 
 // Confirms player has tile in player's hand
-bool Player::containsTile(Tile* tile) {
-    for (int i = 0; i < hand.getLength(); ++i) {
-        if (*(hand.get(i)) == *tile) {
-            return true;
-        }
-    }
-    return false;
+bool Player::containsTile(Tile tile) {
+    return hand.contains(tile);
 }
 
+UnseenTiles Player::getUnseenTiles(const GameBoard& board) const {
+    return UnseenTiles(board, hand);
+}
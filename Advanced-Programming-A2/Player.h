@@ -3,8 +3,11 @@
 
 #include <string>
 #include <vector>
-#include "LinkedList.h"
+#include "Hand.h"
 #include "TileBag.h"
+#include "UnseenTiles.h"
+
+class GameBoard;
 
 class Player {
 public:
@@ -38,34 +41,34 @@ public:
     // Setter for player score
     void setScore(int newScore);
 
-    // Add a tile to the player's hand
-    void addTileToHand(Tile* tile);
+    // Add a tile to the player's hand, false if the hand is already full
+    bool addTileToHand(Tile tile);
 
-    // Add quantity of tiles to player's hand
+    // Add quantity of tiles to player's hand, stopping early once the hand is full
     void drawQuantityTiles(TileBag* tileBag, int quantity);
 
-    // Remove a tile from the player's hand
-    Tile* removeTileFromHand(Tile* tile);
+    // Remove a tile from the player's hand, false if the hand does not have it
+    bool removeTileFromHand(Tile tile);
 
     // Get the player's hand
-    LinkedList* getHand();
+    Hand* getHand();
 
     // Setter for player's hand (initializes hand with given tiles)
-    void setHand(const std::vector<Tile*>& tiles);
+    void setHand(const std::vector<Tile>& tiles);
 
     // Get the string representation of the player's hand
     std::string toString() const; // Added toString method
 
     // Confirms player has tile in player's hand
-    bool containsTile(Tile* tile);
+    bool containsTile(Tile tile);
+
+    // Tiles this player can not see, in the bag or the opponent's hand
+    UnseenTiles getUnseenTiles(const GameBoard& board) const;
 
 private:
     std::string name;
     int score;
-    LinkedList hand;
-
-    // Helper function to clear resources
-    void clear();
+    Hand hand;
 };
 
 #endif // ASSIGN2_PLAYER_H
@@ -0,0 +1,48 @@
+#ifndef ASSIGN2_RANDOM_H
+#define ASSIGN2_RANDOM_H
+
+#include <cstdint>
+
+/*
+ * A small, fast random number generator (splitmix64). Its whole state is one
+ * number, so it can be saved with a game and restored to replay the same draws.
+ */
+class Random {
+public:
+    explicit Random(std::uint64_t seed = 0) : state(seed) {}
+
+    std::uint64_t next() {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // A number from 0 to bound - 1, every value equally likely
+    std::uint32_t below(std::uint32_t bound) {
+        // Scale the top 32 bits into range, rejecting the few values that would favour low numbers
+        std::uint64_t scaled = (next() >> 32) * bound;
+        std::uint32_t low = (std::uint32_t)scaled;
+        if (low < bound) {
+            std::uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                scaled = (next() >> 32) * bound;
+                low = (std::uint32_t)scaled;
+            }
+        }
+        return (std::uint32_t)(scaled >> 32);
+    }
+
+    // A number in [0, 1)
+    double nextDouble() {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    std::uint64_t getState() const { return state; }
+    void setState(std::uint64_t state) { this->state = state; }
+
+private:
+    std::uint64_t state;
+};
+
+#endif // ASSIGN2_RANDOM_H
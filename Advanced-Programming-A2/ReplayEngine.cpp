@@ -0,0 +1,154 @@
+#include "ReplayEngine.h"
+#include <algorithm>
+#include "FileHandler.h"
+#include "MappedFile.h"
+#include "SaveFormat.h"
+#include "TileSet.h"
+
+ReplayEngine::ReplayEngine(int keyframeInterval)
+    : keyframeInterval(std::max(1, keyframeInterval)), rows(0), cols(0), move(0) {
+    position.scores[0] = 0;
+    position.scores[1] = 0;
+    position.playerToMove = 0;
+}
+
+bool ReplayEngine::load(const std::string& saveFile) {
+    Player first("FIRST");
+    Player second("SECOND");
+    Player current("CURRENT");
+    TileBag tileBag;
+    GameBoard* gameBoard = new GameBoard();
+    bool aiMode = false;
+    FileHandler fileHandler;
+    bool loaded = fileHandler.loadGame(saveFile, &first, &second, &tileBag, gameBoard, &current, aiMode, false);
+
+    MappedFile save;
+    std::vector<JournalRecord> records;
+    if (loaded && save.open(saveFile)) {
+        MoveJournal::readRecords(saveFile, saveChecksum(save.getData(), save.getSize()), records);
+    }
+    if (loaded) {
+        reset(SaveSnapshot(saveFile, &first, &second, &tileBag, gameBoard, &current, aiMode), records);
+    }
+    delete gameBoard;
+    return loaded;
+}
+
+void ReplayEngine::reset(const SaveSnapshot& start, const std::vector<JournalRecord>& moves) {
+    names[0] = start.names[0];
+    names[1] = start.names[1];
+    rows = start.rows;
+    cols = start.cols;
+    board.assign(rows * cols, EMPTY_TILE);
+    for (const SavedTile& tile : start.boardTiles) {
+        board[tile.row * cols + tile.col] = tile.code;
+    }
+    for (int i = 0; i < 2; ++i) {
+        position.scores[i] = start.scores[i];
+        position.hands[i] = start.hands[i];
+    }
+    position.tileBag = start.tileBag;
+    position.playerToMove = start.secondToMove ? 1 : 0;
+    move = 0;
+
+    // Play the whole game once, keeping a keyframe every keyframeInterval moves
+    this->moves.clear();
+    this->moves.reserve(moves.size());
+    keyframes.clear();
+    keyframeBoards.clear();
+    for (const JournalRecord& record : moves) {
+        if (!fits(record)) {
+            break;
+        }
+        if (move % keyframeInterval == 0) {
+            saveKeyframe();
+        }
+        this->moves.push_back(record);
+        apply(record);
+        move++;
+    }
+    if (move % keyframeInterval == 0) {
+        saveKeyframe();
+    }
+}
+
+void ReplayEngine::seek(int target) {
+    target = std::max(0, std::min(target, getMoveCount()));
+    // Moving forward within the same keyframe interval carries on from here
+    if (target < move || target / keyframeInterval != move / keyframeInterval) {
+        int keyframe = target / keyframeInterval;
+        position = keyframes[keyframe];
+        std::copy_n(keyframeBoards.begin() + keyframe * board.size(), board.size(), board.begin());
+        move = keyframe * keyframeInterval;
+    }
+    while (move < target) {
+        apply(moves[move]);
+        move++;
+    }
+}
+
+bool ReplayEngine::step() {
+    if (move == getMoveCount()) {
+        return false;
+    }
+    apply(moves[move]);
+    move++;
+    return true;
+}
+
+void ReplayEngine::copyBoard(GameBoard& gameBoard) const {
+    if (gameBoard.getRows() != rows || gameBoard.getCols() != cols) {
+        gameBoard.resize(rows, cols);
+    }
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            TileCode code = getTileCode(row, col);
+            if (code != gameBoard.getTileCode(row, col)) {
+                gameBoard.placeTile(row, col, Tile::fromCode(code));
+            }
+        }
+    }
+}
+
+void ReplayEngine::apply(const JournalRecord& record) {
+    for (int i = 0; i < record.placed; ++i) {
+        board[record.rows[i] * cols + record.cols[i]] = record.tiles[i];
+    }
+    TileBag& tileBag = position.tileBag;
+    for (int i = 0; i < record.drawn; ++i) {
+        tileBag.drawTile();
+    }
+    for (int i = 0; i < record.returned; ++i) {
+        tileBag.addTile(Tile::fromCode(record.returnedTiles[i]));
+    }
+    tileBag.setRandomState(tileBag.getSeed(), record.randomState);
+
+    Hand& hand = position.hands[record.player];
+    hand.clear();
+    for (int i = 0; i < record.handLength; ++i) {
+        hand.add(Tile::fromCode(record.hand[i]));
+    }
+    position.scores[record.player] = record.score;
+    position.playerToMove = 1 - record.player;
+}
+
+bool ReplayEngine::fits(const JournalRecord& record) const {
+    bool valid = record.player <= 1 && record.placed <= JOURNAL_TURN_TILES && record.returned <= JOURNAL_TURN_TILES &&
+                 record.handLength <= MAX_HAND_SIZE && record.drawn <= position.tileBag.getLength() &&
+                 position.tileBag.getLength() - record.drawn + record.returned <= MAX_BAG_TILES;
+    for (int i = 0; valid && i < record.placed; ++i) {
+        valid = TileSet::contains(Tile::fromCode(record.tiles[i])) && record.rows[i] < rows && record.cols[i] < cols;
+    }
+    for (int i = 0; valid && i < record.returned; ++i) {
+        valid = TileSet::contains(Tile::fromCode(record.returnedTiles[i]));
+    }
+    for (int i = 0; valid && i < record.handLength; ++i) {
+        valid = TileSet::contains(Tile::fromCode(record.hand[i]));
+    }
+    return valid;
+}
+
+void ReplayEngine::saveKeyframe() {
+    keyframes.push_back(position);
+    keyframeBoards.insert(keyframeBoards.end(), board.begin(), board.end());
+}
@@ -0,0 +1,94 @@
+#ifndef ASSIGN2_REPLAYENGINE_H
+#define ASSIGN2_REPLAYENGINE_H
+
+#include <string>
+#include <vector>
+#include "GameBoard.h"
+#include "Hand.h"
+#include "MoveJournal.h"
+#include "SaveWriter.h"
+#include "TileBag.h"
+#include "TileCodes.h"
+
+// Moves between keyframes unless a replay is given another interval
+#define DEFAULT_KEYFRAME_INTERVAL 32
+
+/*
+ * Steps through a recorded game: the position in a save followed by the
+ * turns in its journal. A keyframe of the whole position is kept every
+ * keyframeInterval moves, so seeking to any move restores the keyframe at or
+ * before it and replays at most keyframeInterval - 1 moves from there.
+ *
+ * The moves were checked when they were played, so replaying them skips the
+ * rules. The board is a plain grid of tile codes rather than a GameBoard, and a
+ * move is only a few cell writes and a copy of the mover's hand.
+ */
+class ReplayEngine {
+public:
+    explicit ReplayEngine(int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+
+    // Load a save and the turns journalled after it, false if the save can not be loaded.
+    // Like reset, this leaves the replay at the end of the game.
+    bool load(const std::string& saveFile);
+
+    // Start from a position and the turns played after it, playing through to the end to
+    // build the keyframes. The moves are only checked to fit the board, bag and tile set
+    // here, and the game ends before the first move that does not.
+    void reset(const SaveSnapshot& start, const std::vector<JournalRecord>& moves);
+
+    // Moves that can be replayed, positions run from 0 for the start to getMoveCount()
+    int getMoveCount() const { return moves.size(); }
+    int getKeyframeInterval() const { return keyframeInterval; }
+
+    // Go to the position after a number of moves, clamped to the recorded game
+    void seek(int move);
+    // Play the next move, false at the end of the game
+    bool step();
+
+    // The current position
+    int getMove() const { return move; }
+    const std::string& getName(int player) const { return names[player]; }
+    int getScore(int player) const { return position.scores[player]; }
+    const Hand& getHand(int player) const { return position.hands[player]; }
+    const TileBag& getTileBag() const { return position.tileBag; }
+    // 0 when the first player in the save is to move, 1 for the second
+    int getPlayerToMove() const { return position.playerToMove; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    TileCode getTileCode(int row, int col) const { return board[row * cols + col]; }
+
+    // Place the current position's tiles on a board of the same size, for display
+    void copyBoard(GameBoard& gameBoard) const;
+
+private:
+    // Everything in a position apart from the board
+    struct Position {
+        int scores[2];
+        Hand hands[2];
+        TileBag tileBag;
+        int playerToMove;
+    };
+
+    int keyframeInterval;
+    std::string names[2];
+    int rows;
+    int cols;
+    std::vector<JournalRecord> moves;
+
+    // Keyframe k is the position after k * keyframeInterval moves, with its board
+    // at k * rows * cols in keyframeBoards
+    std::vector<Position> keyframes;
+    std::vector<TileCode> keyframeBoards;
+
+    int move;
+    Position position;
+    std::vector<TileCode> board;
+
+    // Apply a move to the current position without checking it
+    void apply(const JournalRecord& record);
+    // Check a move fits the board and bag of the current position
+    bool fits(const JournalRecord& record) const;
+    void saveKeyframe();
+};
+
+#endif // ASSIGN2_REPLAYENGINE_H
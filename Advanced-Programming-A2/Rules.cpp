@@ -1,46 +1,21 @@
 #include "Rules.h"
-#include <set>
+#include "TileCodes.h"
 
-bool Rules::validateMove(GameBoard* board, Tile* tile, int x, int y) {
+bool Rules::validateMove(GameBoard* board, Tile tile, int x, int y) {
     return isValidPlacement(board, tile, x, y);
 }
 
 int Rules::calculateScore(GameBoard* board, int x, int y) {
-    int rowTiles = 1;
-    int colTiles = 1;
-
-    // Check horizontal (row) tiles
-    for (int i = x - 1; i >= 0 && board->getTile(i, y) != nullptr; --i) {
-        rowTiles++;
-    }
-    for (int i = x + 1; i < board->getRows() && board->getTile(i, y) != nullptr; ++i) {
-        rowTiles++;
-    }
-
-    // Check vertical (column) tiles
-    for (int j = y - 1; j >= 0 && board->getTile(x, j) != nullptr; --j) {
-        colTiles++;
-    }
-    for (int j = y + 1; j < board->getCols() && board->getTile(x, j) != nullptr; ++j) {
-        colTiles++;
-    }
+    // The board indexes the lines through every cell. An empty cell's runs exclude
+    // the cell itself, so the tile about to be placed there is counted on top.
+    int placedTile = board->getTileCode(x, y) == EMPTY_TILE ? 1 : 0;
+    LineRun rowTiles = board->getColumnRun(x, y);
+    LineRun colTiles = board->getRowRun(x, y);
+    rowTiles.length += placedTile;
+    colTiles.length += placedTile;
 
     // Calculate the score
-    int score = 0;
-    if (rowTiles > 1) {
-        score += rowTiles;
-    }
-    if (colTiles > 1) {
-        score += colTiles;
-    }
-
-    // Check for QWIRKLEs and add bonus points if applicable
-    if (rowTiles == 6) {
-        score += 6;
-    }
-    if (colTiles == 6) {
-        score += 6;
-    }
+    int score = scoreLine(rowTiles) + scoreLine(colTiles);
 
     // If this is the first move, add one point
     if (score == 0) {
@@ -52,100 +27,94 @@ int Rules::calculateScore(GameBoard* board, int x, int y) {
 
 
 
-bool Rules::isGameOver(Player* player1, Player* player2, TileBag* tileBag) {
-    return (player1->getHand()->getHead() == nullptr && player2->getHand()->getHead() == nullptr) && tileBag->isEmpty();
+TileMask Rules::lineLegalTiles(const LineRun& run) {
+    if (run.length == 0) {
+        return allTiles();
+    }
+    TileMask legal = 0;
+    // A single colour line takes that colour in any shape the line does not have yet
+    if (run.colours > 1 && (run.colours & (run.colours - 1)) == 0) {
+        int colour = __builtin_ctz(run.colours);
+        TileMask missingShapes = (~run.shapes >> 1) & 0xFF;
+        legal |= missingShapes << ((colour - 1) * 8);
+    }
+    // A single shape line takes that shape in any colour the line does not have yet
+    if (run.shapes > 1 && (run.shapes & (run.shapes - 1)) == 0) {
+        int shape = __builtin_ctz(run.shapes);
+        for (int colour = 1; colour <= 8; ++colour) {
+            if ((run.colours & (1u << colour)) == 0) {
+                legal |= 1ull << ((colour - 1) * 8 + (shape - 1));
+            }
+        }
+    }
+    return legal & allTiles();
 }
 
-bool Rules::isValidPlacement(GameBoard* board, Tile* tile, int x, int y) {
+bool Rules::isValidLine(const LineRun& run) {
+    bool oneColour = run.colours != 0 && (run.colours & (run.colours - 1)) == 0;
+    bool oneShape = run.shapes != 0 && (run.shapes & (run.shapes - 1)) == 0;
+    return (oneColour && __builtin_popcount(run.shapes) == run.length) ||
+           (oneShape && __builtin_popcount(run.colours) == run.length);
+}
 
-    // Check if the position is within the board's boundaries
-    if (x < 0 || x >= board->getRows() || y < 0 || y >= board->getCols()) {
-        return false;
+int Rules::scoreLine(const LineRun& line) {
+    if (line.length <= 1) {
+        return 0;
     }
+    // Completing a line is a QWIRKLE and scores a bonus of the line's length, six points in the standard game
+    return isQwirkle(line) ? line.length * 2 : line.length;
+}
 
-    // Allow the first move to be placed anywhere
-    if (board->isEmpty()) {
-        return true;
-    }
-    
-    /*Check if the tile has a proxy tile 
-    added this function as an early exit to avoid the extra computation of 
-    all the other checks if the tile has no proxy tile.
-    This aids the Ai in making decisions faster as it can avoid checking
-    */
-    if (!hasProxyTile(board, x, y)) {
+bool Rules::isQwirkle(const LineRun& line) {
+    if (line.length <= 1) {
         return false;
     }
+    bool oneColour = (line.colours & (line.colours - 1)) == 0;
+    bool oneShape = (line.shapes & (line.shapes - 1)) == 0;
+    return (oneColour && line.length == TileSet::getShapes()) || (oneShape && line.length == TileSet::getColours());
+}
 
-    // Check if the position is already occupied
-    if (board->getTile(x, y) != nullptr) {
-        return false;
-    }
-    
-    // Check if tile placement is valid    
-    if (isRowInvalid(board, tile, x, y)) {
-        return false;
-    }
-    
-    return true;
+TileMask Rules::allTiles() {
+    return TileSet::getAllTiles();
 }
 
-bool Rules::isRowInvalid(GameBoard* board, Tile* tile, int x, int y) {
-    // Check if horizontal (row) already has the tile
-    std::set<std::string> horizontalRowTileMatch;
-    std::set<std::string> verticalRowTileMatch;
-    
-    // build set of matches for horizontal rows
-    for (int i = x - 1; i >= 0 && board->getTile(i, y) != nullptr; --i) {
-        horizontalRowTileMatch.insert(tile->matchType(*board->getTile(i, y)));
-    }
-    for (int i = x + 1; i < board->getRows() && board->getTile(i, y) != nullptr; ++i) {
-        horizontalRowTileMatch.insert(tile->matchType(*board->getTile(i, y)));
-    }
-    
-    // build set of matches for vertical rows
-    for (int j = y - 1; j >= 0 && board->getTile(x, j) != nullptr; --j) {
-        verticalRowTileMatch.insert(tile->matchType(*board->getTile(x, j)));
-    }
-    for (int j = y + 1; j < board->getCols() && board->getTile(x, j) != nullptr; ++j) {
-        verticalRowTileMatch.insert(tile->matchType(*board->getTile(x, j)));
+TileMask Rules::handTiles(Player* player) {
+    return player->getHand()->getMask();
+}
 
+bool Rules::hasLegalMove(GameBoard* board, Player* player) {
+    TileMask hand = handTiles(player);
+    if (board->isEmpty()) {
+        return hand != 0;
     }
-    
-    // Check if the tile does not have a valid match in either row
-    if (horizontalRowTileMatch.count("no-match") > 0 || verticalRowTileMatch.count("no-match") > 0) {
-        return true;
-    }
-    // Check if the tile has a match where it is the same tile
-    if (horizontalRowTileMatch.count("same") > 0 || verticalRowTileMatch.count("same") > 0) {
-        return true;
-    }
-    // Check if the tile has a match by both color and shape
-    if (horizontalRowTileMatch.count("color") > 0 && horizontalRowTileMatch.count("shape") > 0) {
-        return true;
-    }
-    // Check if the tile has a match by both color and shape
-    if (verticalRowTileMatch.count("color") > 0 && verticalRowTileMatch.count("shape") > 0) {
-        return true;
+    for (const BoardCell& cell : board->getFrontier()) {
+        if ((board->getLegalTiles(cell.row, cell.col) & hand) != 0) {
+            return true;
+        }
     }
-    // Check if the tile has a match by both color and shape
-    if (horizontalRowTileMatch.size() > 1 || verticalRowTileMatch.size() > 1) {
-        return true;
+    return false;
+}
+
+// The game ends once the bag is empty and neither player can place a tile, which includes both hands being empty
+bool Rules::isGameOver(Player* player1, Player* player2, TileBag* tileBag, GameBoard* board) {
+    return tileBag->isEmpty() && !hasLegalMove(board, player1) && !hasLegalMove(board, player2);
+}
+
+bool Rules::isValidPlacement(GameBoard* board, Tile tile, int x, int y) {
+
+    // Check if the position is within the board's boundaries
+    if (x < 0 || x >= board->getRows() || y < 0 || y >= board->getCols()) {
+        return false;
     }
-    
-    // Check if the tile has no matches
-    if (horizontalRowTileMatch.size() == 0 && verticalRowTileMatch.size() == 0) {
+
+    // Allow the first move to be placed anywhere
+    if (board->isEmpty()) {
         return true;
     }
-    
-    return false;
-    
-}
 
-bool Rules::hasProxyTile(GameBoard* board, int x, int y){
-    bool leftTile = board->getTile(x - 1, y) != nullptr;
-    bool rightTile = board->getTile(x + 1, y) != nullptr;
-    bool upTile = board->getTile(x, y - 1) != nullptr;
-    bool downTile = board->getTile(x, y + 1) != nullptr;
-    return leftTile || rightTile || upTile || downTile;
-}
\ No newline at end of file
+    /*The board keeps the set of tiles each frontier cell can take up to date
+    as tiles are placed, and every cell off the frontier takes none, so
+    validating a placement is a single bit test.
+    */
+    return (board->getLegalTiles(x, y) & Tile::tileBit(tile.getCode())) != 0;
+}
@@ -4,26 +4,46 @@
 #include "GameBoard.h"
 #include "Player.h"
 #include "TileBag.h"
+#include "TileSet.h"
 
 class Rules {
 public:
     // Validate a move
-    static bool validateMove(GameBoard* board, Tile* tile, int x, int y);
+    static bool validateMove(GameBoard* board, Tile tile, int x, int y);
 
     // Calculate the score of a move
     static int calculateScore(GameBoard* board, int x, int y);
 
+    // Tiles that can join a line of tiles described by its run. A line takes a tile when every
+    // tile shares its colour and none its shape, or every tile shares its shape and none its colour.
+    // An empty line takes any tile.
+    static TileMask lineLegalTiles(const LineRun& run);
+
+    // Check if a whole line is legal, all one colour with no repeated shape or all one shape with no repeated colour
+    static bool isValidLine(const LineRun& run);
+
+    // Points scored by a line of tiles containing a newly placed tile, a single tile scores nothing
+    static int scoreLine(const LineRun& line);
+
+    // Check if a line holds every tile its colour or shape allows, which scores a QWIRKLE.
+    // A line of one colour is complete with every shape in the tile set, one shape with every colour.
+    static bool isQwirkle(const LineRun& line);
+
+    // Every tile in the game's tile set
+    static TileMask allTiles();
+
+    // Tiles held in a player's hand
+    static TileMask handTiles(Player* player);
+
+    // Check if any tile in the player's hand can be placed anywhere on the board
+    static bool hasLegalMove(GameBoard* board, Player* player);
+
     // Check if the game is over
-    static bool isGameOver(Player* player1, Player* player2, TileBag* tileBag);
+    static bool isGameOver(Player* player1, Player* player2, TileBag* tileBag, GameBoard* board);
 
 private:
     // Helper functions for move validation and scoring
-    static bool isValidPlacement(GameBoard* board, Tile* tile, int x, int y);
-    
-    // Check if tile placement is valid in rows
-    static bool isRowInvalid(GameBoard* board, Tile* tile, int x, int y);
-    
-    static bool hasProxyTile(GameBoard* board, int x, int y);
+    static bool isValidPlacement(GameBoard* board, Tile tile, int x, int y);
 };
 
 #endif // ASSIGN2_RULES_H
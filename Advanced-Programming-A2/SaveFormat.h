@@ -0,0 +1,70 @@
+#ifndef ASSIGN2_SAVEFORMAT_H
+#define ASSIGN2_SAVEFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/*
+ * Layout of a binary save. A fixed SaveHeader is followed by:
+ *   the two player names, nameLengths bytes each, with no terminator
+ *   the two hands, one TileCode per tile
+ *   the board, boardTiles records of TileCode, row, col (one byte each)
+ *   the bag, bagTiles TileCodes in draw order
+ * Numbers are stored in the byte order of the machine that saved the game.
+ * The checksum covers the whole file with the checksum field itself set to 0.
+ */
+
+// First bytes of every binary save
+#define SAVE_MAGIC "QWKB"
+#define SAVE_MAGIC_LENGTH 4
+
+// Bumped whenever the layout changes, loaders reject versions they do not know
+#define SAVE_VERSION 1
+
+// Saves whose file name ends in this are written and read in the binary format
+#define BINARY_SAVE_EXTENSION ".qwb"
+
+// Bits of SaveHeader::flags
+#define SAVE_AI_MODE 0x01
+#define SAVE_SECOND_PLAYER_TO_MOVE 0x02
+
+// Bytes in one board tile record
+#define SAVE_BOARD_RECORD_SIZE 3
+
+struct SaveHeader {
+    char magic[SAVE_MAGIC_LENGTH];
+    std::uint16_t version;
+    // Where the tile data starts, so a later version can grow the header
+    std::uint16_t headerSize;
+    std::uint8_t colours;
+    std::uint8_t shapes;
+    std::uint8_t copies;
+    std::uint8_t flags;
+    std::uint8_t rows;
+    std::uint8_t cols;
+    std::uint8_t nameLengths[2];
+    std::uint8_t handLengths[2];
+    std::uint16_t boardTiles;
+    std::uint16_t bagTiles;
+    std::uint16_t reserved;
+    std::int32_t scores[2];
+    // The bag's generator, as in TileBag::setRandomState
+    std::uint64_t seed;
+    std::uint64_t randomState;
+    std::uint64_t checksum;
+};
+
+static_assert(sizeof(SaveHeader) == 56, "The save header has no padding between fields");
+static_assert(std::is_trivially_copyable<SaveHeader>::value, "Save headers are copied as plain bytes");
+
+// FNV-1a over a run of bytes, pass the previous result to carry on over several runs
+inline std::uint64_t saveChecksum(const unsigned char* data, std::size_t size,
+                                  std::uint64_t hash = 0xCBF29CE484222325ull) {
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+#endif // ASSIGN2_SAVEFORMAT_H
@@ -0,0 +1,151 @@
+#include "SaveParser.h"
+#include <climits>
+#include <cstring>
+#include "TileSet.h"
+
+bool TextView::operator==(const char* text) const {
+    return std::strlen(text) == length && std::memcmp(data, text, length) == 0;
+}
+
+SaveParser::SaveParser(const char* data, std::size_t size)
+    : data(data), size(size), position(0), line(1), lineStart(0), finished(size == 0), fieldLine(1), fieldColumn(1), error{0, 0, ""} {
+}
+
+bool SaveParser::readLine(TextView& text) {
+    if (!startField()) {
+        return false;
+    }
+    std::size_t start = position;
+    while (!atLineEnd()) {
+        position++;
+    }
+    text.data = data + start;
+    text.length = position - start;
+    return endLine();
+}
+
+bool SaveParser::readNumber(int& value) {
+    if (!startField()) {
+        return false;
+    }
+    std::uint64_t number = 0;
+    if (!readUnsigned(number, INT_MAX)) {
+        return false;
+    }
+    value = number;
+    return endLine();
+}
+
+bool SaveParser::readPair(std::uint64_t& first, std::uint64_t& second) {
+    if (!startField()) {
+        return false;
+    }
+    if (!readUnsigned(first, UINT64_MAX)) {
+        return false;
+    }
+    if (peek() != ',') {
+        return failHere("Expected a comma between two numbers");
+    }
+    position++;
+    return readUnsigned(second, UINT64_MAX) && endLine();
+}
+
+bool SaveParser::fail(const std::string& message) {
+    if (error.line == 0) {
+        error = {fieldLine, fieldColumn, message};
+    }
+    return false;
+}
+
+bool SaveParser::startField() {
+    markField();
+    return !finished || fail("The save ends early");
+}
+
+void SaveParser::markField() {
+    fieldLine = line;
+    fieldColumn = position - lineStart + 1;
+}
+
+bool SaveParser::failHere(const std::string& message) {
+    markField();
+    return fail(message);
+}
+
+// A line ends at a newline, a Windows style carriage return and newline, or the end of the file
+bool SaveParser::atLineEnd() const {
+    return position == size || data[position] == '\n' ||
+           (data[position] == '\r' && (position + 1 == size || data[position + 1] == '\n'));
+}
+
+bool SaveParser::endLine() {
+    if (!atLineEnd()) {
+        return failHere("Unexpected text at the end of the line");
+    }
+    if (position < size && data[position] == '\r') {
+        position++;
+    }
+    if (position < size) {
+        position++;
+        line++;
+        lineStart = position;
+    }
+    // A newline at the very end does not start another line
+    finished = position == size;
+    return true;
+}
+
+// Digits up to a limit, with no sign or spaces
+bool SaveParser::readUnsigned(std::uint64_t& value, std::uint64_t limit) {
+    if (position == size || data[position] < '0' || data[position] > '9') {
+        return failHere("Expected a number");
+    }
+    std::size_t start = position;
+    value = 0;
+    while (position < size && data[position] >= '0' && data[position] <= '9') {
+        unsigned digit = data[position] - '0';
+        if (value > (limit - digit) / 10) {
+            position = start;
+            return failHere("Number is too large");
+        }
+        value = value * 10 + digit;
+        position++;
+    }
+    return true;
+}
+
+// A colour letter and a shape number, which must be a tile in the game's tile set
+bool SaveParser::readTile(Tile& tile) {
+    std::size_t start = position;
+    if (position == size || data[position] < 'A' || data[position] > 'Z') {
+        return failHere("Expected a tile");
+    }
+    Colour colour = data[position++];
+    std::uint64_t shape = 0;
+    if (!readUnsigned(shape, 15)) {
+        return false;
+    }
+    tile = Tile(colour, shape);
+    if (!TileSet::contains(tile)) {
+        std::string text(data + start, data + position);
+        position = start;
+        return failHere("Tile " + text + " is not in the tile set");
+    }
+    return true;
+}
+
+// A row letter and a column number, such as B12
+bool SaveParser::readCell(int& row, int& col) {
+    // Rows past Z carry on through the characters after it. Text saves are no longer written
+    // with them, but older saves may have them.
+    if (position == size || (unsigned char)data[position] < 'A') {
+        return failHere("Expected a row letter");
+    }
+    row = (unsigned char)data[position++] - 'A';
+    std::uint64_t number = 0;
+    if (!readUnsigned(number, INT_MAX)) {
+        return false;
+    }
+    col = number;
+    return true;
+}
@@ -0,0 +1,145 @@
+#ifndef ASSIGN2_SAVEPARSER_H
+#define ASSIGN2_SAVEPARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Tile.h"
+
+// A part of a text save, pointing into the parser's buffer rather than copying it
+struct TextView {
+    const char* data;
+    std::size_t length;
+
+    bool operator==(const char* text) const;
+    std::string toString() const { return std::string(data, length); }
+};
+
+// What went wrong and where, line and column count from 1
+struct SaveParseError {
+    int line;
+    int column;
+    std::string message;
+};
+
+/*
+ * Reads the fields of a text save one line at a time, straight out of the
+ * file's buffer. Every read takes its field and the end of its line and
+ * returns false on bad input, with the first error kept in getError. Tiles
+ * are handed to a callback as they are read, so nothing is built per tile.
+ */
+class SaveParser {
+public:
+    SaveParser(const char* data, std::size_t size);
+
+    // The whole of the next line, which may be empty
+    bool readLine(TextView& line);
+    // A line holding one number
+    bool readNumber(int& value);
+    // A line holding two numbers with a comma between them
+    bool readPair(std::uint64_t& first, std::uint64_t& second);
+
+    // A line of comma separated tiles, such as "R1,G2", calling add(tile) for each one.
+    // add returns false to reject a tile, such as one too many for a hand.
+    template <typename Add>
+    bool readTiles(Add add);
+
+    // A line of comma separated tiles and their cells, such as "R1@A0,G2@B12",
+    // calling place(tile, row, col) for each one
+    template <typename Place>
+    bool readPlacedTiles(Place place);
+
+    // Check if every line has been read, reading on from there is an error
+    bool atEnd() const { return finished; }
+
+    const SaveParseError& getError() const { return error; }
+
+    // Record an error at the start of the field just read, for checks made by the caller.
+    // Always false, so it can be returned directly.
+    bool fail(const std::string& message);
+
+private:
+    const char* data;
+    std::size_t size;
+    std::size_t position;
+    int line;
+    std::size_t lineStart;
+    bool finished;
+    // Where the last field started, for errors found after reading it
+    int fieldLine;
+    int fieldColumn;
+    SaveParseError error;
+
+    // Start a field, false once there are no lines left
+    bool startField();
+    void markField();
+    bool failHere(const std::string& message);
+
+    char peek() const { return position < size ? data[position] : '\n'; }
+    bool atLineEnd() const;
+    bool endLine();
+
+    bool readUnsigned(std::uint64_t& value, std::uint64_t limit);
+    bool readTile(Tile& tile);
+    bool readCell(int& row, int& col);
+    template <typename Item>
+    bool readList(Item item);
+};
+
+template <typename Add>
+bool SaveParser::readTiles(Add add) {
+    return readList([&]() {
+        Tile tile;
+        markField();
+        if (!readTile(tile)) {
+            return false;
+        }
+        return add(tile) || fail("Tile " + tile.print() + " does not fit here");
+    });
+}
+
+template <typename Place>
+bool SaveParser::readPlacedTiles(Place place) {
+    return readList([&]() {
+        Tile tile;
+        int row = 0;
+        int col = 0;
+        markField();
+        if (!readTile(tile)) {
+            return false;
+        }
+        if (peek() != '@') {
+            return failHere("Expected @ and a cell after tile " + tile.print());
+        }
+        position++;
+        if (!readCell(row, col)) {
+            return false;
+        }
+        return place(tile, row, col);
+    });
+}
+
+// Comma separated items up to the end of the line, an empty line has none
+template <typename Item>
+bool SaveParser::readList(Item item) {
+    if (!startField()) {
+        return false;
+    }
+    if (atLineEnd()) {
+        return endLine();
+    }
+    while (true) {
+        if (!item()) {
+            return false;
+        }
+        if (atLineEnd()) {
+            return endLine();
+        }
+        if (peek() != ',') {
+            return failHere("Expected a comma or the end of the line");
+        }
+        position++;
+    }
+}
+
+#endif // ASSIGN2_SAVEPARSER_H
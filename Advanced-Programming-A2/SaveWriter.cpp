@@ -0,0 +1,92 @@
+#include "SaveWriter.h"
+#include "FileHandler.h"
+#include "TileCodes.h"
+
+SaveSnapshot::SaveSnapshot(const std::string& filename, Player* player1, Player* player2, TileBag* tileBag,
+                           GameBoard* board, Player* currentPlayer, bool aiMode)
+    : filename(filename), names{player1->getName(), player2->getName()}, scores{player1->getScore(), player2->getScore()},
+      hands{*player1->getHand(), *player2->getHand()}, rows(board->getRows()), cols(board->getCols()),
+      tileBag(*tileBag), secondToMove(currentPlayer->getName() != player1->getName()), aiMode(aiMode) {
+    boardTiles.reserve(board->getTileCount());
+    for (int row = board->getMinRow(); row <= board->getMaxRow(); ++row) {
+        for (int col = board->getMinCol(); col <= board->getMaxCol(); ++col) {
+            TileCode code = board->getTileCode(row, col);
+            if (code != EMPTY_TILE) {
+                boardTiles.push_back({code, row, col});
+            }
+        }
+    }
+}
+
+SaveWriter::SaveWriter() : writing(false), stopping(false) {
+}
+
+SaveWriter::~SaveWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    snapshotReady.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void SaveWriter::submit(SaveSnapshot snapshot) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!thread.joinable()) {
+            thread = std::thread(&SaveWriter::work, this);
+        }
+        // A newer snapshot of a file makes a waiting one pointless
+        bool replaced = false;
+        for (SaveSnapshot& waiting : pending) {
+            if (!replaced && waiting.filename == snapshot.filename) {
+                waiting = std::move(snapshot);
+                replaced = true;
+            }
+        }
+        if (!replaced) {
+            pending.push_back(std::move(snapshot));
+        }
+    }
+    snapshotReady.notify_one();
+}
+
+bool SaveWriter::takeResult(SaveResult& result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (results.empty()) {
+        return false;
+    }
+    result = std::move(results.front());
+    results.pop_front();
+    return true;
+}
+
+void SaveWriter::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    writesDone.wait(lock, [this] { return pending.empty() && !writing; });
+}
+
+void SaveWriter::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        snapshotReady.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            return;
+        }
+        SaveSnapshot snapshot = std::move(pending.front());
+        pending.pop_front();
+        writing = true;
+
+        // The file is written without holding the lock, so the game can queue the next snapshot meanwhile
+        lock.unlock();
+        SaveResult result = {snapshot.filename, false, ""};
+        result.saved = FileHandler::writeSnapshot(snapshot, result.error);
+        lock.lock();
+
+        results.push_back(std::move(result));
+        writing = false;
+        writesDone.notify_all();
+    }
+}
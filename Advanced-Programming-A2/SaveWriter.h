@@ -0,0 +1,90 @@
+#ifndef ASSIGN2_SAVEWRITER_H
+#define ASSIGN2_SAVEWRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GameBoard.h"
+#include "Hand.h"
+#include "Player.h"
+#include "TileBag.h"
+
+// A tile on the board as a save records it
+struct SavedTile {
+    TileCode code;
+    int row;
+    int col;
+};
+
+/*
+ * Everything a save file holds, copied out of the game so it can be written
+ * while the game carries on. Taking one copies the names, the hands and the
+ * bag and walks only the occupied part of the board.
+ */
+struct SaveSnapshot {
+    SaveSnapshot(const std::string& filename, Player* player1, Player* player2, TileBag* tileBag,
+                 GameBoard* board, Player* currentPlayer, bool aiMode);
+
+    std::string filename;
+    std::string names[2];
+    int scores[2];
+    Hand hands[2];
+    int rows;
+    int cols;
+    // In the order of the board's rows, then columns
+    std::vector<SavedTile> boardTiles;
+    TileBag tileBag;
+    bool secondToMove;
+    bool aiMode;
+};
+
+// How a write finished, error is empty when it was saved
+struct SaveResult {
+    std::string filename;
+    bool saved;
+    std::string error;
+};
+
+/*
+ * Writes save snapshots on a background thread so the game never waits on
+ * the disk. Each save is written to a temporary file that replaces the old
+ * save only once it is complete. If a file is saved again before an earlier
+ * snapshot of it has been written, only the newest one is written.
+ */
+class SaveWriter {
+public:
+    SaveWriter();
+    // Writes every snapshot still waiting before returning
+    ~SaveWriter();
+
+    SaveWriter(const SaveWriter& other) = delete;
+    SaveWriter& operator=(const SaveWriter& other) = delete;
+
+    // Queue a snapshot to be written, the writer thread is started by the first one
+    void submit(SaveSnapshot snapshot);
+
+    // Take the result of the oldest finished write, false if there are none. Never waits.
+    bool takeResult(SaveResult& result);
+
+    // Wait until every snapshot submitted so far has been written
+    void wait();
+
+private:
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable snapshotReady;
+    std::condition_variable writesDone;
+
+    std::deque<SaveSnapshot> pending;
+    std::deque<SaveResult> results;
+    bool writing;
+    bool stopping;
+
+    // Write snapshots as they arrive until stopping with nothing left to write
+    void work();
+};
+
+#endif // ASSIGN2_SAVEWRITER_H
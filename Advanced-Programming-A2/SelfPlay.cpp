@@ -0,0 +1,153 @@
+#include "SelfPlay.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "Ai.h"
+#include "FileHandler.h"
+#include "MoveJournal.h"
+#include "Rules.h"
+#include "SaveWriter.h"
+#include "ThreadPool.h"
+#include "TileSet.h"
+
+#define SELFPLAY_HAND_SIZE 6
+
+typedef std::chrono::steady_clock Clock;
+
+int SelfPlay::run(int argc, char** argv) {
+    int games = 1;
+    int threads = 1;
+    unsigned int seed = 1;
+    std::string recordFile;
+    bool aiThreadsGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        // The AI and tile set options are read by main before self-play starts
+        aiThreadsGiven = aiThreadsGiven || option.compare(0, 13, "--ai-threads=") == 0;
+        if (option == "selfplay" || option.compare(0, 5, "--ai-") == 0 || option.compare(0, 10, "--colours=") == 0 ||
+            option.compare(0, 9, "--shapes=") == 0 || option.compare(0, 9, "--copies=") == 0) {
+            continue;
+        }
+        try {
+            if (i + 1 < argc && option == "--games") {
+                games = std::stoi(argv[++i]);
+            } else if (i + 1 < argc && option == "--threads") {
+                threads = std::stoi(argv[++i]);
+            } else if (i + 1 < argc && option == "--seed") {
+                seed = std::stoul(argv[++i]);
+            } else if (i + 1 < argc && option == "--record") {
+                recordFile = argv[++i];
+            } else {
+                throw std::invalid_argument(option);
+            }
+        } catch (const std::exception &) {
+            std::cerr << "Usage: ./qwirkle.exe selfplay --games N --threads T --seed S [--record FILE]" << std::endl;
+            return 1;
+        }
+    }
+    games = std::max(1, games);
+    threads = std::max(1, threads);
+
+    // Games run side by side, so unless --ai-threads= says otherwise each AI searches on the
+    // thread playing its game
+    if (threads > 1 && !aiThreadsGiven) {
+        Ai::setWorkers(1);
+    }
+
+    std::vector<GameResult> results(games);
+    ThreadPool pool(threads);
+    Clock::time_point start = Clock::now();
+    pool.run(games, [&](int game) {
+        playGame(seed + game, results[game], game == 0 ? recordFile : "");
+    });
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    long moves = 0;
+    long swaps = 0;
+    double totalScores[2] = {0, 0};
+    int wins[2] = {0, 0};
+    std::vector<double> moveTimes;
+    std::vector<double> swapTimes;
+    for (const GameResult& result : results) {
+        moves += result.moveTimesMs.size();
+        swaps += result.swapTimesMs.size();
+        for (int player = 0; player < 2; ++player) {
+            totalScores[player] += result.scores[player];
+        }
+        if (result.scores[0] != result.scores[1]) {
+            wins[result.scores[0] > result.scores[1] ? 0 : 1]++;
+        }
+        moveTimes.insert(moveTimes.end(), result.moveTimesMs.begin(), result.moveTimesMs.end());
+        swapTimes.insert(swapTimes.end(), result.swapTimesMs.begin(), result.swapTimesMs.end());
+    }
+    std::sort(moveTimes.begin(), moveTimes.end());
+    std::sort(swapTimes.begin(), swapTimes.end());
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Self-play: " << games << " games on " << threads << " threads with " << Ai::getWorkers()
+              << " AI search threads each from seed " << seed << std::endl;
+    std::cout << "Tile set: " << TileSet::getColours() << " colours, " << TileSet::getShapes() << " shapes, "
+              << TileSet::getCopies() << " copies on a " << TileSet::getBoardSize() << "x" << TileSet::getBoardSize() << " board" << std::endl;
+    std::cout << "Games/sec: " << games / seconds << std::endl;
+    // A move is a turn that places tiles, a swap is a turn that trades tiles or passes
+    std::cout << "Turns: " << moves + swaps << ", " << moves << " moves placing tiles and " << swaps << " swaps" << std::endl;
+    std::cout << "Moves/sec: " << moves / seconds << std::endl;
+    std::cout << "Turns/sec: " << (moves + swaps) / seconds << std::endl;
+    std::cout << "Average score: first player " << totalScores[0] / games << ", second player " << totalScores[1] / games << std::endl;
+    std::cout << "Wins: first player " << wins[0] << ", second player " << wins[1] << ", draws " << games - wins[0] - wins[1] << std::endl;
+    std::cout << "Move latency (ms): p50 " << percentile(moveTimes, 0.5) << ", p90 " << percentile(moveTimes, 0.9)
+              << ", p99 " << percentile(moveTimes, 0.99) << ", max " << percentile(moveTimes, 1.0) << std::endl;
+    std::cout << "Swap latency (ms): p50 " << percentile(swapTimes, 0.5) << ", p90 " << percentile(swapTimes, 0.9)
+              << ", p99 " << percentile(swapTimes, 0.99) << ", max " << percentile(swapTimes, 1.0) << std::endl;
+    return 0;
+}
+
+void SelfPlay::playGame(unsigned int seed, GameResult& result, const std::string& recordFile) {
+    GameBoard board(TileSet::getBoardSize(), TileSet::getBoardSize());
+    TileBag tileBag;
+    tileBag.shuffle(seed);
+    Player first("FIRST");
+    Player second("SECOND");
+    Player* players[2] = {&first, &second};
+    for (Player* player : players) {
+        player->drawQuantityTiles(&tileBag, SELFPLAY_HAND_SIZE);
+    }
+
+    // A recorded game is the dealt position saved to the file and every turn in its journal
+    MoveJournal journal;
+    std::string error;
+    if (!recordFile.empty() &&
+        (!FileHandler::writeSnapshot(SaveSnapshot(recordFile, &first, &second, &tileBag, &board, &first, true), error) ||
+         !journal.start(recordFile, &first, &second))) {
+        std::cerr << "Error: Unable to record the game to " << recordFile << std::endl;
+    }
+
+    for (int turn = 0; turn < MAX_SELFPLAY_TURNS && !Rules::isGameOver(&first, &second, &tileBag, &board); ++turn) {
+        journal.beginTurn(&tileBag, &board);
+        Clock::time_point start = Clock::now();
+        Move move;
+        // Every turn is timed, swaps search every subset of the hand and are often the slowest
+        bool placed = Ai::takeTurn(players[turn % 2], &tileBag, &board, move);
+        double timeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        (placed ? result.moveTimesMs : result.swapTimesMs).push_back(timeMs);
+        if (placed) {
+            journal.recordMove(move);
+        }
+        if (!journal.endTurn(players[turn % 2], &tileBag, &board)) {
+            std::cerr << "Error: Turn " << turn + 1 << " could not be recorded" << std::endl;
+            journal.stop();
+        }
+    }
+    result.scores[0] = first.getScore();
+    result.scores[1] = second.getScore();
+}
+
+double SelfPlay::percentile(const std::vector<double>& sortedTimes, double fraction) {
+    if (sortedTimes.empty()) {
+        return 0;
+    }
+    size_t index = std::min(sortedTimes.size() - 1, (size_t)(fraction * sortedTimes.size()));
+    return sortedTimes[index];
+}
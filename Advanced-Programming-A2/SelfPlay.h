@@ -0,0 +1,33 @@
+#ifndef ASSIGN2_SELFPLAY_H
+#define ASSIGN2_SELFPLAY_H
+
+#include <string>
+#include <vector>
+
+// Most turns a self-play game may take, in case both players keep swapping tiles
+#define MAX_SELFPLAY_TURNS 1000
+
+// Plays whole games between two AI players without any input or board output
+class SelfPlay {
+public:
+    // Run "selfplay --games N --threads T --seed S" and print games, moves and turns per second,
+    // average scores and the latency of moves and of swaps. Game i is dealt from seed S + i, so
+    // a run can be repeated exactly. "--record FILE" saves the first game to FILE and journals
+    // its turns, for a replay. Returns the exit status.
+    static int run(int argc, char** argv);
+
+private:
+    struct GameResult {
+        int scores[2];
+        // Time taken by each turn that placed tiles, and by each turn that swapped or passed
+        std::vector<double> moveTimesMs;
+        std::vector<double> swapTimesMs;
+    };
+
+    static void playGame(unsigned int seed, GameResult& result, const std::string& recordFile);
+
+    // Value below which the given fraction of the sorted times fall
+    static double percentile(const std::vector<double>& sortedTimes, double fraction);
+};
+
+#endif // ASSIGN2_SELFPLAY_H
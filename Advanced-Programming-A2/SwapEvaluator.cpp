@@ -0,0 +1,167 @@
+#include "SwapEvaluator.h"
+#include <algorithm>
+#include "DrawSampler.h"
+#include "MoveGenerator.h"
+
+int SwapEvaluator::chooseSwap(const GameBoard& board, const Hand& hand, const UnseenTiles& unseen,
+                              int bagSize, Clock::time_point deadline) {
+    int handSize = hand.getLength();
+    int mostTiles = std::min(handSize, bagSize);
+    if (mostTiles == 0) {
+        return 0;
+    }
+
+    // Draws come out of the tiles the player can not see, one entry per copy
+    std::vector<TileCode> unseenTiles;
+    for (TileMask remaining = unseen.getMask(); remaining != 0; remaining &= remaining - 1) {
+        Tile tile = Tile::fromCode(Tile::indexCode(__builtin_ctzll(remaining)));
+        unseenTiles.insert(unseenTiles.end(), unseen.count(tile), tile.getCode());
+    }
+
+    HandScores scores;
+    scores.fits = board.isEmpty() ? ~0ull : 0;
+    for (const BoardCell& cell : board.getFrontier()) {
+        scores.fits |= board.getLegalTiles(cell.row, cell.col);
+    }
+    std::vector<unsigned long long> tried;
+    int bestSwap = 0;
+    double bestValue = -1;
+    for (int tiles = 1; tiles <= mostTiles; ++tiles) {
+        for (int swap = 1; swap < 1 << handSize; ++swap) {
+            if (__builtin_popcount(swap) != tiles) {
+                continue;
+            }
+            // The first set is always rated so there is a swap to make however little time is left
+            if (bestSwap != 0 && Clock::now() >= deadline) {
+                return bestSwap;
+            }
+
+            // Trading either copy of a doubled tile is the same trade
+            std::vector<TileCode> traded;
+            for (int i = 0; i < handSize; ++i) {
+                if (swap & (1 << i)) {
+                    traded.push_back(hand.get(i).getCode());
+                }
+            }
+            std::sort(traded.begin(), traded.end());
+            unsigned long long key = 0;
+            for (TileCode tile : traded) {
+                key = key << 8 | tile;
+            }
+            if (std::find(tried.begin(), tried.end(), key) != tried.end()) {
+                continue;
+            }
+            tried.push_back(key);
+
+            // Ties go to the smaller trade, which keeps more of a hand already known
+            double value = rateSwap(board, hand, swap, unseen, unseenTiles, scores);
+            if (value > bestValue) {
+                bestValue = value;
+                bestSwap = swap;
+            }
+        }
+    }
+    return bestSwap;
+}
+
+double SwapEvaluator::rateSwap(const GameBoard& board, const Hand& hand, int swap, const UnseenTiles& unseen,
+                               const std::vector<TileCode>& unseenTiles, HandScores& scores) {
+    std::vector<TileCode> kept;
+    for (int i = 0; i < hand.getLength(); ++i) {
+        if (!(swap & (1 << i))) {
+            kept.push_back(hand.get(i).getCode());
+        }
+    }
+    int draws = hand.getLength() - (int)kept.size();
+    int total = unseenTiles.size();
+    if (total < draws) {
+        return 0;
+    }
+
+    // Number of ways to draw, stopping the count once it is too many to try
+    double outcomes = 1;
+    for (int i = 0; i < draws && outcomes <= EXACT_SWAP_OUTCOMES; ++i) {
+        outcomes = outcomes * (total - i) / (i + 1);
+    }
+
+    std::vector<TileCode> drawn = kept;
+    double sum = 0;
+    int rated = 0;
+    if (outcomes <= EXACT_SWAP_OUTCOMES) {
+        // Every set of copies that could be drawn, each as likely as the next
+        std::vector<int> picks(draws);
+        for (int i = 0; i < draws; ++i) {
+            picks[i] = i;
+        }
+        while (true) {
+            drawn.resize(kept.size());
+            for (int pick : picks) {
+                drawn.push_back(unseenTiles[pick]);
+            }
+            sum += bestScore(board, drawn, scores);
+            rated++;
+
+            // Step to the next set of positions in order
+            int i = draws - 1;
+            while (i >= 0 && picks[i] == total - draws + i) {
+                --i;
+            }
+            if (i < 0) {
+                break;
+            }
+            picks[i]++;
+            for (int j = i + 1; j < draws; ++j) {
+                picks[j] = picks[j - 1] + 1;
+            }
+        }
+    } else {
+        // The same hand and trade always sample the same draws, so the choice is repeatable
+        std::uint64_t seed = swap;
+        for (TileCode tile : kept) {
+            seed = seed * 31 + tile;
+        }
+        DrawSampler sampler(unseen, seed);
+        for (int sample = 0; sample < SWAP_SAMPLES; ++sample) {
+            // Each sample draws from its own copy of the full set
+            DrawSampler hypothetical = sampler;
+            hypothetical.reseed(seed + sample);
+            drawn.resize(kept.size());
+            for (int i = 0; i < draws; ++i) {
+                drawn.push_back(hypothetical.draw().getCode());
+            }
+            sum += bestScore(board, drawn, scores);
+            rated++;
+        }
+    }
+    return sum / rated;
+}
+
+int SwapEvaluator::bestScore(const GameBoard& board, std::vector<TileCode> hand, HandScores& scores) {
+    // A hand with no tile that fits anywhere can not move
+    TileMask handMask = 0;
+    for (TileCode tile : hand) {
+        handMask |= Tile::tileBit(tile);
+    }
+    if ((handMask & scores.fits) == 0) {
+        return 0;
+    }
+
+    std::sort(hand.begin(), hand.end());
+    unsigned long long key = 0;
+    for (TileCode tile : hand) {
+        key = key << 8 | tile;
+    }
+    std::unordered_map<unsigned long long, int>::iterator known = scores.known.find(key);
+    if (known != scores.known.end()) {
+        return known->second;
+    }
+
+    std::vector<Move> moves;
+    MoveGenerator::generateMoves(board, hand, moves);
+    int best = 0;
+    for (const Move& move : moves) {
+        best = std::max(best, move.score);
+    }
+    scores.known[key] = best;
+    return best;
+}
@@ -0,0 +1,48 @@
+#ifndef ASSIGN2_SWAPEVALUATOR_H
+#define ASSIGN2_SWAPEVALUATOR_H
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+#include "GameBoard.h"
+#include "Hand.h"
+#include "UnseenTiles.h"
+
+// Most draw outcomes a swap is rated over exactly, more than this are sampled
+#define EXACT_SWAP_OUTCOMES 64
+
+// Draws sampled to rate a swap when there are too many outcomes to try them all
+#define SWAP_SAMPLES 8
+
+/*
+ * Picks which tiles to trade back into the bag. Every set of tiles in the hand
+ * is rated by the expected score of the best move the hand could make after
+ * the trade, drawing from the tiles the player can not see.
+ */
+class SwapEvaluator {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    // Positions in the hand to trade, one bit each, 0 when nothing can be traded. Each set is
+    // rated exactly over every draw when there are few enough, otherwise over a fixed sample
+    // of draws. Sets are tried smallest first and the best rated once the deadline passes wins.
+    static int chooseSwap(const GameBoard& board, const Hand& hand, const UnseenTiles& unseen,
+                          int bagSize, Clock::time_point deadline = Clock::time_point::max());
+
+private:
+    // Best move scores already worked out, keyed by the sorted tile codes of a hand,
+    // with every tile that fits somewhere on the board so most hands need no search
+    struct HandScores {
+        std::unordered_map<unsigned long long, int> known;
+        TileMask fits;
+    };
+
+    // Expected best move score after trading the tiles in swap
+    static double rateSwap(const GameBoard& board, const Hand& hand, int swap, const UnseenTiles& unseen,
+                           const std::vector<TileCode>& unseenTiles, HandScores& scores);
+
+    // Best move score for a hand, looked up in scores when seen before
+    static int bestScore(const GameBoard& board, std::vector<TileCode> hand, HandScores& scores);
+};
+
+#endif // ASSIGN2_SWAPEVALUATOR_H
@@ -1,8 +1,22 @@
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <iterator>
 #include "TileBag.h"
+#include "LinkedList.h"
 #include "TileCodes.h"
 #include "FileHandler.h"
+#include "MoveGenerator.h"
+#include "Ai.h"
+#include "DrawSampler.h"
+#include "TileSet.h"
+#include "Rules.h"
+#include "SaveFormat.h"
+#include "SaveParser.h"
+#include "MoveJournal.h"
+#include "SaveWriter.h"
+#include "ReplayEngine.h"
 
 class Tests
 {
@@ -15,20 +29,39 @@ class Tests
         tileBagShuffleTest();
         readFileContentTest();
         saveGameTest();
+        textSaveRowLimitTest();
+        binarySaveTest();
+        saveParserTest();
+        moveJournalTest();
+        saveWriterTest();
+        replayEngineTest();
         enhancedTileTest();
+        gameBoardPackedStorageTest();
+        gameBoardFrontierTest();
+        gameBoardEdgeTest();
+        moveGeneratorTest();
+        parallelMoveSearchTest();
+        timedMoveSearchTest();
+        handCountTableTest();
+        linkedListNodePoolTest();
+        linkedListIteratorTest();
+        unseenTilesTest();
+        swapEvaluatorTest();
+        drawSamplerTest();
+        tileSetVariantTest();
     }
     
     static void tileBagConstructorOverloadTest()
     {
         std::cout << "#tileBagConstructorOverloadTest" << std::endl;
         // given
-        std::vector<Tile*> tileVector = std::vector<Tile*>({ new Tile(RED, CIRCLE), new Tile(RED, STAR_4)});
+        std::vector<Tile> tileVector = std::vector<Tile>({ Tile(RED, CIRCLE), Tile(RED, STAR_4)});
         
         // when
         TileBag *tilebag = new TileBag(tileVector);
         
         // then
-        std::string tileString = tilebag->getTiles()->toString();
+        std::string tileString = tilebag->toString();
         std::cout << "Tilebag instantiated with tiles: " << tileString << std::endl;
         
         assert_equality("R1, R2", tileString);
@@ -39,13 +72,12 @@ class Tests
         std::cout << "#tileShuffleTest" << std::endl;
         // given
         TileBag *tilebag = new TileBag();        
-        LinkedList *tiles = tilebag->getTiles();
-        std::string tileString = tiles->toString();
+        std::string tileString = tilebag->toString();
         int randSeed = (unsigned int)time(NULL);
         
         // when
         tilebag->shuffle(randSeed);
-        std::string shuffledTileString = tiles->toString();
+        std::string shuffledTileString = tilebag->toString();
         
         // then
         std::cout << "Original: " << tileString << std::endl;
@@ -77,10 +109,10 @@ class Tests
         Player player1("ALICE");
         Player player2("BOB");
 
-        Tile* tile1 = new Tile('R', 1); // Red, Shape 1
-        Tile* tile2 = new Tile('G', 2); // Green, Shape 2
-        Tile* tile3 = new Tile('B', 3); // Blue, Shape 3
-        Tile* tile4 = new Tile('Y', 4); // Yellow, Shape 4
+        Tile tile1('R', 1); // Red, Shape 1
+        Tile tile2('G', 2); // Green, Shape 2
+        Tile tile3('B', 3); // Blue, Shape 3
+        Tile tile4('Y', 4); // Yellow, Shape 4
 
         player1.addTileToHand(tile1);
         player2.addTileToHand(tile2);
@@ -88,8 +120,9 @@ class Tests
         GameBoard board(6, 6); // 6x6 board
         board.placeTile(3, 3, tile3); // Place tile4 at D3
 
-        std::vector<Tile*> tiles = { tile4 };
+        std::vector<Tile> tiles = { tile4 };
         TileBag* tileBag = new TileBag(tiles);
+        tileBag->shuffle(7);
 
         Player currentPlayer("ALICE"); // Example current player
         
@@ -100,23 +133,344 @@ class Tests
 
         // // then
         std::string fileContent = fileHandler.readFileContent("tests/stubs/save-game-test-stub.txt");
-        std::string savedGame = "ALICE\n0\nR1\nBOB\n0\nG2\n6,6\nB3@D3\nY4\nALICE\nSTD";
+        std::string savedGame = "ALICE\n0\nR1\nBOB\n0\nG2\n6,6\nB3@D3\nY4\nALICE\nSTD\n7,7";
         
         assert_equality(savedGame, fileContent);
     }
     
+    static void textSaveRowLimitTest()
+    {
+        std::cout << "#textSaveRowLimitTest" << std::endl;
+        // given
+        Player player1("ALICE");
+        Player player2("BOB");
+        GameBoard board(MAX_TEXT_SAVE_ROWS + 4, 6);
+        board.placeTile(MAX_TEXT_SAVE_ROWS + 2, 3, Tile(RED, CIRCLE));
+        std::vector<Tile> tiles = {Tile(ORANGE, CLOVER)};
+        TileBag tileBag(tiles);
+        std::string textFile = "./tests/stubs/tall-board-test.txt";
+        std::string binaryFile = "./tests/stubs/tall-board-test.qwb";
+
+        // when
+        // A row past Z has no letter, so only the binary format can hold the board
+        std::string textError;
+        std::string binaryError;
+        bool textSaved = FileHandler::writeSnapshot(SaveSnapshot(textFile, &player1, &player2, &tileBag, &board, &player1, false), textError);
+        bool textLeft = FileHandler::fileExists(textFile);
+        bool binarySaved = FileHandler::writeSnapshot(SaveSnapshot(binaryFile, &player1, &player2, &tileBag, &board, &player1, false), binaryError);
+
+        Player loaded1("TEMP1");
+        Player loaded2("TEMP2");
+        Player current("CURRENT");
+        TileBag loadedBag;
+        GameBoard* loadedBoard = new GameBoard();
+        bool aiMode = false;
+        FileHandler fileHandler;
+        bool loaded = fileHandler.loadGame(binaryFile, &loaded1, &loaded2, &loadedBag, loadedBoard, &current, aiMode);
+        std::remove(textFile.c_str());
+        std::remove(binaryFile.c_str());
+
+        // then
+        std::string result = std::string(textSaved ? "text saved" : "text failed: " + textError) +
+                             (textLeft ? ", text file left" : "") + (binarySaved ? ", binary saved" : ", binary failed") +
+                             (loaded ? ", loaded " : ", not loaded ") + loadedBoard->getTile(MAX_TEXT_SAVE_ROWS + 2, 3).print();
+        std::cout << "Tall board saves: " << result << std::endl;
+        delete loadedBoard;
+
+        assert_equality("text failed: A board of 30 rows is too tall for a text save, use a .qwb file, binary saved, loaded R1", result);
+    }
+
+    static void binarySaveTest()
+    {
+        std::cout << "#binarySaveTest" << std::endl;
+        // given
+        Player player1("ALICE");
+        Player player2("BOB");
+        player1.setScore(12);
+        player1.addTileToHand(Tile(RED, CIRCLE));
+        player1.addTileToHand(Tile(GREEN, STAR_4));
+        player2.addTileToHand(Tile(BLUE, DIAMOND));
+
+        GameBoard board(6, 6);
+        board.placeTile(3, 3, Tile(YELLOW, SQUARE));
+        board.placeTile(3, 4, Tile(YELLOW, STAR_6));
+
+        std::vector<Tile> tiles = {Tile(ORANGE, CLOVER), Tile(PURPLE, CIRCLE)};
+        TileBag tileBag(tiles);
+        tileBag.shuffle(7);
+
+        // when
+        std::string filename = "./tests/stubs/save-game-test-stub.qwb";
+        FileHandler fileHandler;
+        fileHandler.saveGame(filename, &player1, &player2, &tileBag, &board, &player2, true);
+
+        Player loaded1("TEMP1");
+        Player loaded2("TEMP2");
+        Player current("CURRENT");
+        TileBag loadedBag;
+        GameBoard* loadedBoard = new GameBoard();
+        bool aiMode = false;
+        bool loaded = fileHandler.loadGame(filename, &loaded1, &loaded2, &loadedBag, loadedBoard, &current, aiMode);
+
+        // A save with one byte changed is turned away by its checksum
+        std::string damagedName = "./tests/stubs/save-game-test-damaged.qwb";
+        std::ifstream original(filename, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(original)), std::istreambuf_iterator<char>());
+        bytes[bytes.size() - 1] ^= 1;
+        std::ofstream(damagedName, std::ios::binary) << bytes;
+        bool damagedLoaded = fileHandler.loadGame(damagedName, &loaded1, &loaded2, &loadedBag, loadedBoard, &current, aiMode);
+        std::remove(damagedName.c_str());
+
+        // A save with a valid checksum that puts both board tiles on one cell is turned away too
+        SaveHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        std::size_t boardStart = header.headerSize + header.nameLengths[0] + header.nameLengths[1] +
+                                 header.handLengths[0] + header.handLengths[1];
+        std::string duplicate = bytes;
+        duplicate[duplicate.size() - 1] ^= 1; // undo the damage above
+        duplicate[boardStart + SAVE_BOARD_RECORD_SIZE + 1] = duplicate[boardStart + 1];
+        duplicate[boardStart + SAVE_BOARD_RECORD_SIZE + 2] = duplicate[boardStart + 2];
+        header.checksum = 0;
+        std::memcpy(&duplicate[0], &header, sizeof(header));
+        header.checksum = saveChecksum(reinterpret_cast<const unsigned char*>(duplicate.data()), duplicate.size());
+        std::memcpy(&duplicate[0], &header, sizeof(header));
+        std::ofstream(damagedName, std::ios::binary) << duplicate;
+        bool duplicateLoaded = fileHandler.loadGame(damagedName, &loaded1, &loaded2, &loadedBag, loadedBoard, &current, aiMode);
+        std::remove(damagedName.c_str());
+
+        // then
+        std::string result = std::string(loaded ? "loaded " : "failed ") + loaded1.getName() + " " +
+                             std::to_string(loaded1.getScore()) + " " + loaded1.getHand()->toString() + ", " +
+                             loaded2.getName() + " " + loaded2.getHand()->toString() + ", board " +
+                             loadedBoard->getTile(3, 3).print() + loadedBoard->getTile(3, 4).print() + " " +
+                             std::to_string(loadedBoard->getRows()) + "x" + std::to_string(loadedBoard->getCols()) +
+                             ", bag " + loadedBag.toString() + " " + std::to_string(loadedBag.getSeed()) + ", " +
+                             current.getName() + (aiMode ? " AI" : " STD") + (damagedLoaded ? ", damaged loaded" : "") +
+                             (duplicateLoaded ? ", duplicate loaded" : "");
+        std::cout << "Binary save round trip: " << result << std::endl;
+        delete loadedBoard;
+
+        assert_equality("loaded ALICE 12 R1, G2, BOB B3, board Y4Y5 6x6, bag " + tileBag.toString() + " 7, BOB AI", result);
+    }
+
+    static void saveParserTest()
+    {
+        std::cout << "#saveParserTest" << std::endl;
+        // given
+        std::string save = "ALICE\r\n12\r\nR1,G2,Q2\r\n";
+        SaveParser parser(save.data(), save.size());
+        TextView name;
+        int score = 0;
+        std::string hand;
+
+        // when
+        bool read = parser.readLine(name) && parser.readNumber(score) &&
+                    parser.readTiles([&](Tile tile) {
+                        hand += tile.print();
+                        return true;
+                    });
+
+        // then
+        // The tiles before the bad one are read, and the error points at it
+        const SaveParseError& error = parser.getError();
+        std::string result = std::string(read ? "read " : "failed ") + name.toString() + " " + std::to_string(score) +
+                             " " + hand + ", " + std::to_string(error.line) + ":" + std::to_string(error.column) +
+                             " " + error.message;
+        std::cout << "Parsed save: " << result << std::endl;
+
+        assert_equality("failed ALICE 12 R1G2, 3:7 Tile Q2 is not in the tile set", result);
+    }
+
+    static void moveJournalTest()
+    {
+        std::cout << "#moveJournalTest" << std::endl;
+        // given
+        Player player1("ALICE");
+        Player player2("BOB");
+        player1.addTileToHand(Tile(RED, CIRCLE));
+        player1.addTileToHand(Tile(GREEN, STAR_4));
+        player2.addTileToHand(Tile(BLUE, DIAMOND));
+
+        GameBoard board(6, 6);
+        std::vector<Tile> tiles = {Tile(ORANGE, CLOVER), Tile(PURPLE, CIRCLE)};
+        TileBag tileBag(tiles);
+
+        std::string filename = "./tests/stubs/journal-test.txt";
+        FileHandler fileHandler;
+        fileHandler.saveGame(filename, &player1, &player2, &tileBag, &board, &player1, false);
+        MoveJournal journal;
+        bool started = journal.start(filename, &player1, &player2);
+
+        // when
+        // ALICE places R1 and draws a tile, then the game stops partway through writing BOB's turn
+        journal.beginTurn(&tileBag, &board);
+        player1.removeTileFromHand(Tile(RED, CIRCLE));
+        board.placeTile(2, 3, Tile(RED, CIRCLE));
+        journal.recordMove({{{2, 3, Tile(RED, CIRCLE).getCode()}}, 1, 1});
+        player1.setScore(1);
+        player1.addTileToHand(tileBag.drawTile());
+        bool recorded = journal.endTurn(&player1, &tileBag, &board);
+        journal.stop();
+        std::ofstream(MoveJournal::journalFile(filename), std::ios::binary | std::ios::app) << std::string(20, 'x');
+
+        Player loaded1("TEMP1");
+        Player loaded2("TEMP2");
+        Player current("CURRENT");
+        TileBag loadedBag;
+        GameBoard* loadedBoard = new GameBoard();
+        bool aiMode = false;
+        bool loaded = fileHandler.loadGame(filename, &loaded1, &loaded2, &loadedBag, loadedBoard, &current, aiMode);
+        std::remove(MoveJournal::journalFile(filename).c_str());
+        std::remove(filename.c_str());
+
+        // then
+        std::string result = std::string(started && recorded && loaded ? "recovered " : "failed ") +
+                             loaded1.getName() + " " + std::to_string(loaded1.getScore()) + " " +
+                             loaded1.getHand()->toString() + ", board " + loadedBoard->getTile(2, 3).print() +
+                             ", bag " + loadedBag.toString() + ", " + current.getName() + " to play";
+        std::cout << "Journal replay: " << result << std::endl;
+        delete loadedBoard;
+
+        assert_equality("recovered ALICE 1 G2, O6, board R1, bag P1, BOB to play", result);
+    }
+
+    static void saveWriterTest()
+    {
+        std::cout << "#saveWriterTest" << std::endl;
+        // given
+        Player player1("ALICE");
+        Player player2("BOB");
+        player1.addTileToHand(Tile(RED, CIRCLE));
+        GameBoard board(6, 6);
+        std::vector<Tile> tiles = {Tile(ORANGE, CLOVER), Tile(PURPLE, CIRCLE)};
+        TileBag tileBag(tiles);
+        std::string filename = "./tests/stubs/save-writer-test.qwb";
+
+        // when
+        // The game carries on after each snapshot is taken, the second snapshot is the one that counts
+        SaveWriter saveWriter;
+        saveWriter.submit(SaveSnapshot(filename, &player1, &player2, &tileBag, &board, &player1, false));
+        board.placeTile(2, 2, Tile(RED, CIRCLE));
+        player1.removeTileFromHand(Tile(RED, CIRCLE));
+        player1.setScore(1);
+        saveWriter.submit(SaveSnapshot(filename, &player1, &player2, &tileBag, &board, &player2, false));
+        board.placeTile(2, 3, Tile(RED, STAR_4));
+        saveWriter.submit(SaveSnapshot("./tests/missing-folder/save.txt", &player1, &player2, &tileBag, &board, &player2, false));
+        saveWriter.wait();
+
+        // The first snapshot may or may not have been written before the second replaced it
+        std::string saveResult = "none";
+        std::string missingResult = "none";
+        SaveResult result;
+        while (saveWriter.takeResult(result)) {
+            (result.filename == filename ? saveResult : missingResult) = result.saved ? "saved" : "failed";
+        }
+        bool tempLeft = FileHandler::fileExists(filename + SAVE_TEMP_EXTENSION);
+
+        Player loaded1("TEMP1");
+        Player loaded2("TEMP2");
+        Player current("CURRENT");
+        TileBag loadedBag;
+        GameBoard* loadedBoard = new GameBoard();
+        bool aiMode = false;
+        FileHandler fileHandler;
+        bool loaded = fileHandler.loadGame(filename, &loaded1, &loaded2, &loadedBag, loadedBoard, &current, aiMode);
+        std::remove(filename.c_str());
+
+        // then
+        std::string saved = std::string(loaded ? "loaded " : "failed ") + loaded1.getName() + " " +
+                            std::to_string(loaded1.getScore()) + ", board " + loadedBoard->getTile(2, 2).print() + " of " +
+                            std::to_string(loadedBoard->getTileCount()) + ", " + current.getName() + " to play" +
+                            (tempLeft ? ", temporary file left" : "");
+        std::string results = saveResult + ", missing folder " + missingResult + ", " + saved;
+        std::cout << "Background saves: " << results << std::endl;
+        delete loadedBoard;
+
+        assert_equality("saved, missing folder failed, loaded ALICE 1, board R1 of 1, BOB to play", results);
+    }
+
+    static void replayEngineTest()
+    {
+        std::cout << "#replayEngineTest" << std::endl;
+        // given
+        Player player1("ALICE");
+        Player player2("BOB");
+        player1.addTileToHand(Tile(RED, CIRCLE));
+        player1.addTileToHand(Tile(RED, STAR_4));
+        player2.addTileToHand(Tile(BLUE, DIAMOND));
+        GameBoard board(6, 6);
+        std::vector<Tile> tiles = {Tile(ORANGE, CLOVER), Tile(PURPLE, CIRCLE)};
+        TileBag tileBag(tiles);
+        SaveSnapshot start("replay", &player1, &player2, &tileBag, &board, &player1, false);
+
+        // ALICE places R1 and draws, BOB passes, then ALICE places R2 and draws
+        auto record = [](int player, int score, Tile placed, int col, std::vector<Tile> hand) {
+            JournalRecord move;
+            std::memset(&move, 0, sizeof(move));
+            move.player = player;
+            move.score = score;
+            if (!placed.isEmpty()) {
+                move.placed = 1;
+                move.drawn = 1;
+                move.tiles[0] = placed.getCode();
+                move.rows[0] = 2;
+                move.cols[0] = col;
+            }
+            move.handLength = hand.size();
+            for (size_t i = 0; i < hand.size(); ++i) {
+                move.hand[i] = hand[i].getCode();
+            }
+            return move;
+        };
+        std::vector<JournalRecord> moves = {
+            record(0, 1, Tile(RED, CIRCLE), 2, {Tile(RED, STAR_4), Tile(ORANGE, CLOVER)}),
+            record(1, 0, Tile(), 0, {Tile(BLUE, DIAMOND)}),
+            record(0, 3, Tile(RED, STAR_4), 3, {Tile(ORANGE, CLOVER), Tile(PURPLE, CIRCLE)}),
+        };
+
+        // when
+        // Keyframes every 2 moves, seeking to move 1 replays from the start and to move 3 from move 2
+        ReplayEngine replay(2);
+        replay.reset(start, moves);
+        auto describe = [&replay]() {
+            std::string tilesPlaced;
+            for (int col = 0; col < replay.getCols(); ++col) {
+                TileCode code = replay.getTileCode(2, col);
+                tilesPlaced += code == EMPTY_TILE ? "" : Tile::fromCode(code).print();
+            }
+            return "move " + std::to_string(replay.getMove()) + " " + replay.getName(0) + " " +
+                   std::to_string(replay.getScore(0)) + " " + replay.getHand(0).toString() + ", board " +
+                   tilesPlaced + ", bag " + std::to_string(replay.getTileBag().getLength()) + ", " +
+                   replay.getName(replay.getPlayerToMove()) + " to play";
+        };
+        replay.seek(1);
+        std::string result = describe();
+        replay.seek(3);
+        result += "; " + describe();
+        replay.seek(0);
+        replay.step();
+        replay.step();
+        result += "; " + describe();
+
+        // then
+        std::cout << "Replay: " << result << std::endl;
+        assert_equality("move 1 ALICE 1 R2, O6, board R1, bag 1, BOB to play; "
+                        "move 3 ALICE 3 O6, P1, board R1R2, bag 0, BOB to play; "
+                        "move 2 ALICE 1 R2, O6, board R1, bag 1, ALICE to play", result);
+    }
+
     static void enhancedTileTest()
     {
         std::cout << "#enhancedTileTest" << std::endl;
         // given
         std::string expected = "P6 \033[95m✤\033[0m, B5 \033[94m✶\033[0m, G4 \033[92m■\033[0m, Y3 \033[93m◆\033[0m, O2 \033[31m✦\033[0m, R1 \033[91m●\033[0m";
-        LinkedList *tiles = new LinkedList();
-        tiles->addFront(new Tile('R', 1));
-        tiles->addFront(new Tile('O', 2));
-        tiles->addFront(new Tile('Y', 3));
-        tiles->addFront(new Tile('G', 4));
-        tiles->addFront(new Tile('B', 5));
-        tiles->addFront(new Tile('P', 6));
+        LinkedList<Tile> *tiles = new LinkedList<Tile>();
+        tiles->addFront(Tile('R', 1));
+        tiles->addFront(Tile('O', 2));
+        tiles->addFront(Tile('Y', 3));
+        tiles->addFront(Tile('G', 4));
+        tiles->addFront(Tile('B', 5));
+        tiles->addFront(Tile('P', 6));
         
         // when
         std::string tileString = tiles->enhancedPrint();
@@ -127,6 +481,333 @@ class Tests
         assert_equality(expected, tileString);
     }
         
+    static void gameBoardPackedStorageTest()
+    {
+        std::cout << "#gameBoardPackedStorageTest" << std::endl;
+        // given
+        GameBoard board(4, 4);
+        Tile tile(PURPLE, CLOVER);
+
+        // when
+        board.placeTile(2, 3, tile);
+        board.resize(5, 5);
+        GameBoard copy(board);
+
+        // then
+        Tile stored = copy.getTile(2, 3);
+        std::string result = !stored.isEmpty() ? stored.print() : "empty";
+        std::cout << "Tile at C3 after copy and resize: " << result << std::endl;
+
+        assert_equality("P6", result);
+    }
+
+    static void gameBoardFrontierTest()
+    {
+        std::cout << "#gameBoardFrontierTest" << std::endl;
+        // given
+        GameBoard board(3, 3);
+        Tile tile(RED, CIRCLE);
+        std::string sizes;
+
+        // when
+        board.placeTile(1, 1, tile);
+        sizes += std::to_string(board.getFrontier().size()) + ",";
+        board.placeTile(1, 2, tile);
+        sizes += std::to_string(board.getFrontier().size()) + ",";
+        board.placeTile(1, 1, Tile());
+        sizes += std::to_string(board.getFrontier().size());
+
+        // then
+        std::cout << "Frontier sizes after place, place, remove: " << sizes << std::endl;
+
+        assert_equality("4,5,3", sizes);
+    }
+
+    static void gameBoardEdgeTest()
+    {
+        std::cout << "#gameBoardEdgeTest" << std::endl;
+        // given
+        GameBoard board(2, 3);
+
+        // when
+        // A line along the top edge ending in the corner
+        board.placeTile(0, 1, Tile(RED, CIRCLE));
+        board.placeTile(0, 2, Tile(RED, STAR_4));
+
+        // then
+        // Cells past the edge read as empty and the line stops at the corner
+        std::string result = std::to_string(board.getFrontier().size()) + " frontier, " +
+                             std::to_string(board.getRowRun(0, 0).length) + " joined, " +
+                             std::to_string(board.getTileCode(-1, 2)) + std::to_string(board.getTileCode(0, 3)) + " past edge, " +
+                             std::to_string(board.getLegalTiles(0, 3)) + " legal past edge";
+        std::cout << "Board edge: " << result << std::endl;
+
+        assert_equality("3 frontier, 2 joined, 00 past edge, 0 legal past edge", result);
+    }
+
+    static void moveGeneratorTest()
+    {
+        std::cout << "#moveGeneratorTest" << std::endl;
+        // given
+        GameBoard board(5, 5);
+        Tile tile(RED, CIRCLE);
+        board.placeTile(2, 2, tile);
+        std::vector<TileCode> hand = {Tile::encode(RED, STAR_4), Tile::encode(RED, DIAMOND), Tile::encode(YELLOW, STAR_4)};
+
+        // when
+        std::vector<Move> moves;
+        MoveGenerator::generateMoves(board, hand, moves);
+        const Move* bestMove = &moves.front();
+        for (const Move& move : moves) {
+            if (MoveGenerator::isBetterMove(move, *bestMove)) {
+                bestMove = &move;
+            }
+        }
+
+        // then
+        std::string best = MoveGenerator::describeMove(*bestMove) + " for " + std::to_string(bestMove->score);
+        std::cout << "Best move: " << best << std::endl;
+
+        assert_equality("R2 at B1, R3 at B2 for 4", best);
+    }
+
+    static void parallelMoveSearchTest()
+    {
+        std::cout << "#parallelMoveSearchTest" << std::endl;
+        // given
+        GameBoard board(8, 8);
+        std::vector<TileCode> hand = {Tile::encode(RED, STAR_4), Tile::encode(ORANGE, STAR_4), Tile::encode(RED, DIAMOND),
+                                      Tile::encode(BLUE, CIRCLE), Tile::encode(PURPLE, STAR_4), Tile::encode(RED, CIRCLE)};
+        Tile tiles[] = {Tile(RED, CIRCLE), Tile(ORANGE, CIRCLE), Tile(YELLOW, CIRCLE), Tile(YELLOW, STAR_4)};
+        board.placeTile(3, 2, tiles[0]);
+        board.placeTile(3, 3, tiles[1]);
+        board.placeTile(3, 4, tiles[2]);
+        board.placeTile(4, 4, tiles[3]);
+
+        // when
+        std::string bestMoves;
+        for (int workers : {1, 3}) {
+            Ai::setWorkers(workers);
+            Move move;
+            Ai::chooseMove(board, hand, move);
+            bestMoves += MoveGenerator::describeMove(move) + " for " + std::to_string(move.score) + "\n";
+        }
+        Ai::setWorkers(1);
+
+        // then
+        std::cout << "Best moves with 1 and 3 workers:\n" << bestMoves;
+
+        assert_equality("P2 at E1, R2 at E2, O2 at E3 for 8\nP2 at E1, R2 at E2, O2 at E3 for 8\n", bestMoves);
+    }
+
+    static void timedMoveSearchTest()
+    {
+        std::cout << "#timedMoveSearchTest" << std::endl;
+        // given
+        GameBoard board(7, 7);
+        Tile tile(RED, CIRCLE);
+        board.placeTile(3, 3, tile);
+        std::vector<TileCode> hand = {Tile::encode(RED, CIRCLE), Tile::encode(RED, STAR_4), Tile::encode(RED, DIAMOND)};
+
+        // when
+        Move greedyMove;
+        Move timedMove;
+        Ai::chooseMove(board, hand, greedyMove);
+        Ai::chooseMove(board, hand, timedMove, 10000);
+
+        // then
+        std::string moves = MoveGenerator::describeMove(greedyMove) + "\n" + MoveGenerator::describeMove(timedMove);
+        std::cout << "Greedy and timed moves:\n" << moves << std::endl;
+
+        // The timed search keeps R3 back for a second turn worth more than playing it now
+        assert_equality("R1 at B2, R2 at C2, R3 at D2\nR1 at C2, R2 at C3", moves);
+    }
+
+    static void handCountTableTest()
+    {
+        std::cout << "#handCountTableTest" << std::endl;
+        // given
+        Hand hand;
+        hand.add(Tile(RED, CIRCLE));
+        hand.add(Tile(GREEN, STAR_4));
+        hand.add(Tile(RED, CIRCLE));
+        hand.add(Tile(BLUE, SQUARE));
+
+        // when
+        hand.remove(Tile(RED, CIRCLE));
+        hand.remove(Tile(BLUE, SQUARE));
+        Hand copy = hand;
+
+        // then
+        std::string result = copy.toString() + " holds " + std::to_string(copy.count(Tile(RED, CIRCLE))) + " R1, " +
+                             (copy.getMask() & Tile::tileBit(Tile::encode(BLUE, SQUARE)) ? "B4 in mask" : "no B4 in mask");
+        std::cout << "Hand after removals: " << result << std::endl;
+
+        assert_equality("G2, R1 holds 1 R1, no B4 in mask", result);
+    }
+
+    static void linkedListNodePoolTest()
+    {
+        std::cout << "#linkedListNodePoolTest" << std::endl;
+        // given
+        NodePool<Tile> pool;
+        LinkedList<Tile> tiles(&pool);
+        tiles.addBack(Tile(RED, CIRCLE));
+        tiles.addBack(Tile(GREEN, STAR_4));
+
+        // when
+        for (int turn = 0; turn < 100; ++turn) {
+            tiles.addBack(tiles.removeFront());
+        }
+        LinkedList<Tile> copy(tiles);
+
+        // then
+        std::string result = copy.toString() + " from " + std::to_string(pool.getAllocations()) + " nodes in " +
+                             std::to_string(pool.getHeapAllocations()) + " heap block";
+        std::cout << "Pooled list after 100 turns: " << result << std::endl;
+
+        assert_equality("R1, G2 from 104 nodes in 1 heap block", result);
+    }
+
+    static void linkedListIteratorTest()
+    {
+        std::cout << "#linkedListIteratorTest" << std::endl;
+        // given
+        LinkedList<Tile> tiles;
+        for (int shape = CIRCLE; shape <= CLOVER; ++shape) {
+            tiles.addBack(Tile(YELLOW, shape));
+        }
+
+        // when
+        tiles.removeEnd();
+        std::string result;
+        for (int i = 0; i < tiles.getLength(); ++i) {
+            result += tiles.get(i).print();
+        }
+        for (Tile tile : tiles) {
+            result += tile.getColour();
+        }
+        LinkedList<Tile>::const_iterator last = tiles.end();
+        result += (--last)->print();
+
+        // then
+        std::cout << "Indexed, iterated and last tiles: " << result << std::endl;
+
+        assert_equality("Y1Y2Y3Y4Y5YYYYYY5", result);
+    }
+
+    static void unseenTilesTest()
+    {
+        std::cout << "#unseenTilesTest" << std::endl;
+        // given
+        GameBoard board(7, 7);
+        board.placeTile(3, 3, Tile(RED, CIRCLE));
+        Player player("ALICE");
+        player.addTileToHand(Tile(RED, CIRCLE));
+        player.addTileToHand(Tile(GREEN, STAR_4));
+
+        // when
+        UnseenTiles unseen = player.getUnseenTiles(board);
+        unseen.see(Tile(GREEN, STAR_4));
+
+        // then
+        // Next to R1 any other red tile or circle fits, 20 of the 68 tiles left unseen
+        std::string result = std::to_string(unseen.count(Tile(RED, CIRCLE))) + " R1, " +
+                             std::to_string(unseen.count(Tile(GREEN, STAR_4))) + " G2, " +
+                             std::to_string(unseen.getTotal()) + " unseen, " +
+                             std::to_string((int)(unseen.probabilityFits(board, 3, 4) * 68 + 0.5)) + " fit";
+        std::cout << "Unseen tiles: " << result << std::endl;
+
+        assert_equality("0 R1, 0 G2, 68 unseen, 20 fit", result);
+    }
+
+    static void swapEvaluatorTest()
+    {
+        std::cout << "#swapEvaluatorTest" << std::endl;
+        // given
+        GameBoard board(7, 7);
+        for (int shape = CIRCLE; shape <= STAR_6; ++shape) {
+            board.placeTile(3, shape, Tile(RED, shape));
+        }
+        Hand hand;
+        hand.add(Tile(GREEN, CLOVER));
+        hand.add(Tile(BLUE, CIRCLE));
+        // The only tile left to draw is the R6 that completes the line
+        UnseenTiles unseen;
+        for (char colour : colourOrder) {
+            for (int shape = CIRCLE; shape <= CLOVER; ++shape) {
+                Tile tile(colour, shape);
+                while (unseen.count(tile) > (tile == Tile(RED, CLOVER) ? 1 : 0)) {
+                    unseen.see(tile);
+                }
+            }
+        }
+
+        // when
+        int swap = SwapEvaluator::chooseSwap(board, hand, unseen, 1);
+
+        // then
+        // Keeping G6 lets it go above or below the R6 for 2 more points
+        std::string result;
+        for (int i = 0; i < hand.getLength(); ++i) {
+            if (swap & (1 << i)) {
+                result += hand.get(i).print();
+            }
+        }
+        std::cout << "Tiles traded: " << result << std::endl;
+
+        assert_equality("B1", result);
+    }
+
+    static void drawSamplerTest()
+    {
+        std::cout << "#drawSamplerTest" << std::endl;
+        // given
+        std::vector<Tile> tiles = {Tile(PURPLE, SQUARE), Tile(RED, CIRCLE), Tile(PURPLE, SQUARE)};
+        TileBag tileBag(tiles);
+        DrawSampler sampler(tileBag, 11);
+
+        // when
+        int counts[3] = {0, 0, 0};
+        for (int draw = 0; draw < 4; ++draw) {
+            Tile tile = sampler.draw();
+            counts[tile.isEmpty() ? 2 : tile == Tile(RED, CIRCLE) ? 1 : 0]++;
+        }
+
+        // then
+        // Every tile comes out once in some order, and the real bag is left as it was
+        std::string result = std::to_string(counts[0]) + " P4, " + std::to_string(counts[1]) + " R1, " +
+                             std::to_string(counts[2]) + " empty, bag " + tileBag.toString();
+        std::cout << "Sampled draws: " << result << std::endl;
+
+        assert_equality("2 P4, 1 R1, 1 empty, bag P4, R1, P4", result);
+    }
+
+    static void tileSetVariantTest()
+    {
+        std::cout << "#tileSetVariantTest" << std::endl;
+        // given
+        TileSet::configure(MAX_COLOURS, MAX_SHAPES, MAX_COPIES);
+        TileBag tileBag;
+        GameBoard board(TileSet::getBoardSize(), TileSet::getBoardSize());
+
+        // when
+        // A purple line of every shape, which only completes at eight tiles
+        int score = 0;
+        for (int shape = 1; shape <= MAX_SHAPES; ++shape) {
+            board.placeTile(3, shape, Tile(PURPLE, shape));
+            score = Rules::calculateScore(&board, 3, shape);
+        }
+        TileSet::configure(STANDARD_COLOURS, STANDARD_SHAPES, STANDARD_COPIES);
+
+        // then
+        std::string result = std::to_string(tileBag.getLength()) + " tiles, " + std::to_string(board.getRows()) +
+                             " rows, line of 8 scores " + std::to_string(score);
+        std::cout << "Largest tile set: " << result << std::endl;
+
+        assert_equality("256 tiles, 50 rows, line of 8 scores 16", result);
+    }
+
     static void assert_equality(std::string expected, std::string actual)
     {
         if (expected != actual) {
@@ -0,0 +1,74 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int workers)
+    : job(nullptr), taskCount(0), nextTask(0), unfinishedTasks(0), generation(0), stopping(false) {
+    for (int i = 1; i < workers; ++i) {
+        threads.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskReady.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+int ThreadPool::getWorkers() const {
+    return threads.size() + 1;
+}
+
+void ThreadPool::run(int tasks, const std::function<void(int)>& task) {
+    if (tasks <= 0) {
+        return;
+    }
+    // Without any threads the tasks run in turn here, so several callers can share a pool of one
+    if (threads.empty()) {
+        for (int i = 0; i < tasks; ++i) {
+            task(i);
+        }
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    job = &task;
+    taskCount = tasks;
+    nextTask = 0;
+    unfinishedTasks = tasks;
+    generation++;
+    taskReady.notify_all();
+
+    // The calling thread works through the tasks too rather than sitting idle
+    runTasks(lock);
+    tasksDone.wait(lock, [this] { return unfinishedTasks == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    unsigned int seenGeneration = generation;
+    while (true) {
+        taskReady.wait(lock, [this, seenGeneration] { return stopping || generation != seenGeneration; });
+        if (stopping) {
+            return;
+        }
+        seenGeneration = generation;
+        runTasks(lock);
+    }
+}
+
+void ThreadPool::runTasks(std::unique_lock<std::mutex>& lock) {
+    while (job != nullptr && nextTask < taskCount) {
+        int task = nextTask++;
+        const std::function<void(int)>& current = *job;
+        lock.unlock();
+        current(task);
+        lock.lock();
+        if (--unfinishedTasks == 0) {
+            tasksDone.notify_all();
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef ASSIGN2_THREADPOOL_H
+#define ASSIGN2_THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads that share out numbered tasks
+class ThreadPool {
+public:
+    // Workers counts the calling thread, so a pool of one worker starts no threads
+    explicit ThreadPool(int workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    int getWorkers() const;
+
+    // Call task once for every number from 0 to tasks - 1 across the workers,
+    // returning once every call has finished. A pool with threads takes one run at a
+    // time, a pool of one worker runs the tasks on its caller and can be shared freely.
+    void run(int tasks, const std::function<void(int)>& task);
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable taskReady;
+    std::condition_variable tasksDone;
+
+    const std::function<void(int)>* job;
+    int taskCount;
+    int nextTask;
+    int unfinishedTasks;
+    unsigned int generation;
+    bool stopping;
+
+    // Wait for each run and help with its tasks
+    void work();
+
+    // Take and run tasks from the current job until none are left
+    void runTasks(std::unique_lock<std::mutex>& lock);
+};
+
+#endif // ASSIGN2_THREADPOOL_H
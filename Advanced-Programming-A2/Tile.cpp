@@ -2,14 +2,21 @@
 #include <map>
 #include "TileCodes.h"
 
-Tile::Tile(Colour colour, Shape shape) : colour(colour), shape(shape) {}
+Tile::Tile() : code(EMPTY_TILE) {}
+
+Tile::Tile(Colour colour, Shape shape) : code(encode(colour, shape)) {}
 
 Colour Tile::getColour() const {
-    return colour;
+    int colourIndex = code >> 4;
+    return colourIndex >= 1 && colourIndex <= NUM_COLOURS ? colourOrder[colourIndex - 1] : '?';
 }
 
 Shape Tile::getShape() const {
-    return shape;
+    return code & 0x0F;
+}
+
+bool Tile::isEmpty() const {
+    return code == EMPTY_TILE;
 }
 
 // Overload the << operator for the Tile class
@@ -18,14 +25,38 @@ std::ostream& operator<<(std::ostream& os, const Tile& tile) {
     return os;
 }
 
-std::string Tile::print() {
-    return colour + std::to_string(shape);
+std::string Tile::print() const {
+    return getColour() + std::to_string(getShape());
+}
+
+TileCode Tile::getCode() const {
+    return code;
+}
+
+// Colour index is the position in colourOrder + 1 so that no tile packs to EMPTY_TILE
+TileCode Tile::encode(Colour colour, Shape shape) {
+    int colourIndex = 0;
+    for (int i = 0; i < NUM_COLOURS; ++i) {
+        if (colourOrder[i] == colour) {
+            colourIndex = i + 1;
+        }
+    }
+    if (colourIndex == 0 || shape < 1 || shape > 0x0F) {
+        return EMPTY_TILE;
+    }
+    return static_cast<TileCode>((colourIndex << 4) | shape);
+}
+
+Tile Tile::fromCode(TileCode code) {
+    Tile tile;
+    tile.code = code;
+    return tile;
 }
 
 // This function checks if two Tile objects are equal.
 bool Tile::operator==(const Tile& other) const {
 
-    return colour == other.getColour() && shape == other.getShape();
+    return code == other.code;
 }
 
 // This function checks if two Tile objects are not equal.
@@ -34,24 +65,9 @@ bool Tile::operator!=(const Tile& other) const {
     return !(*this == other);
 }
 
-// This function checks if the tile has a match by color or shape, is the same or doesn't match at all
-std::string Tile::matchType(const Tile& other)
-{
-    if (colour == other.getColour() && shape == other.getShape()) {
-        return "same";
-    }
-    if (colour == other.getColour()) {
-        return "color";
-    }
-    if (shape == other.getShape()) {
-        return "shape";
-    }
-    return "no-match";
-}
-
 // This function prints the tile in enhanced mode
-std::string Tile::enhancedPrint() {
+std::string Tile::enhancedPrint() const {
     std::map<int, std::string> shapes = shapeMap;
     std::map<char, std::string> colours = colourMap;
-    return " \033[" + colours[colour] + shapes[shape] + "\033[0m";
+    return " \033[" + colours[getColour()] + shapes[getShape()] + "\033[0m";
 }
\ No newline at end of file
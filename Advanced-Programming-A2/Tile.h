@@ -3,19 +3,72 @@
 
 #include <iostream>
 #include <string>
+#include <type_traits>
 
 
 typedef char Colour;
 typedef int Shape;
 
+// Packed one byte tile representation, 0 is reserved for an empty cell
+typedef unsigned char TileCode;
+
+// Set of distinct tiles, one bit per colour and shape pair
+typedef unsigned long long TileMask;
+
+// Number of slots in a TileMask, one per colour and shape pair
+#define TILE_MASK_BITS 64
+
+// A tile is just its one byte code, so tiles are copied by value and never allocated
 class Tile {
 public:
 
+    // The empty tile, standing for no tile at all
+    Tile();
+
+    // A tile with an unknown colour or a shape outside 1 to 15 is the empty tile
     Tile(Colour colour, Shape shape);
 
     Colour getColour() const;
     Shape getShape() const;
-    std::string print();
+    std::string print() const;
+
+    // Check if this is the empty tile
+    bool isEmpty() const;
+
+    // Packed code for this tile (colour index in the high nibble, shape in the low nibble)
+    TileCode getCode() const;
+
+    // Pack a colour and shape into a tile code
+    static TileCode encode(Colour colour, Shape shape);
+
+    // Tile for a code, the empty tile for EMPTY_TILE
+    static Tile fromCode(TileCode code);
+
+    // Single bit masks for a code's colour and shape, OR'd together to describe a line of tiles.
+    // Defined here so the validation loops can inline them.
+    static unsigned int colourBit(TileCode code) { return 1u << (code >> 4); }
+    static unsigned int shapeBit(TileCode code) { return 1u << (code & 0x0F); }
+
+    // Position of a code's bit in a TileMask, (colour index - 1) * 8 + (shape - 1), or -1 for a code with no bit
+    static int tileIndex(TileCode code) {
+        int colour = code >> 4;
+        int shape = code & 0x0F;
+        if (colour < 1 || colour > 8 || shape < 1 || shape > 8) {
+            return -1;
+        }
+        return (colour - 1) * 8 + (shape - 1);
+    }
+
+    // Code for a position in a TileMask, the inverse of tileIndex
+    static TileCode indexCode(int index) {
+        return (TileCode)(((index / 8 + 1) << 4) | (index % 8 + 1));
+    }
+
+    // Bit for a code in a TileMask, or 0 for a code with no bit
+    static TileMask tileBit(TileCode code) {
+        int index = tileIndex(code);
+        return index < 0 ? 0 : 1ull << index;
+    }
 
     // Function to overload the << operator
     friend std::ostream& operator<<(std::ostream& os, const Tile& tile);
@@ -26,15 +79,14 @@ public:
     // Inequality operator for Tile comparison
     bool operator!=(const Tile& other) const;
     
-    // Function to check if the tile has a match by color or shape
-    std::string matchType(const Tile& other);
-    
     // Function to print the tile in enhanced mode
-    std::string enhancedPrint();
+    std::string enhancedPrint() const;
 
 private:
-    Colour colour;
-    Shape shape;
+    TileCode code;
 };
 
+static_assert(sizeof(Tile) == 1, "A tile packs into a single byte");
+static_assert(std::is_trivially_copyable<Tile>::value, "Tiles are copied as plain bytes");
+
 #endif // ASSIGN2_TILE_H
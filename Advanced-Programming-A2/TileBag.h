@@ -1,49 +1,65 @@
 #ifndef ASSIGN2_TILEBAG_H
 #define ASSIGN2_TILEBAG_H
 
-#include "LinkedList.h"
 #include "Tile.h"
+#include "Random.h"
+#include <cstdint>
+#include <string>
+#include <type_traits>
 #include <vector>
-#include <random>
 
-#define QUANTITY_OF_EACH_TILE 2
+// Most tiles the bag can hold, a power of two so positions wrap with a mask,
+// enough for the largest tile set
+#define MAX_BAG_TILES 256
 
+/*
+ * The tiles left to draw, held in a fixed ring so drawing from the front and
+ * returning tiles to the back are both constant time. The bag keeps the seed
+ * and generator state it was shuffled with so a game can be replayed exactly.
+ */
 class TileBag {
 public:
     TileBag();
-    TileBag(std::vector<Tile*>& tiles);
-    ~TileBag();
+    TileBag(std::vector<Tile>& tiles);
 
-    // Copy constructor
-    TileBag(const TileBag& other);
+    // Reseed the generator and shuffle, a seed of 0 keeps the bag in its current order
+    void shuffle(unsigned int randSeed);
+    // Shuffle again, carrying on from the generator's current state
+    void shuffle();
 
-    // Copy assignment operator
-    TileBag& operator=(const TileBag& other);
+    // Draw the next tile, the empty tile once the bag runs out
+    Tile drawTile();
+    // Return a tile to the back of the bag, throws if the bag is full
+    void addTile(Tile tile);
+    void clear();
 
-    // Move constructor
-    TileBag(TileBag&& other);
+    // The tile at a position counting from the next draw
+    Tile get(int index) const;
+    int getLength() const { return length; }
+    bool isEmpty() const { return length == 0; }
+    // Tiles drawn since the bag was made, so the draws in a turn are the difference across it
+    std::uint64_t getDrawCount() const { return draws; }
+    std::string toString() const;
 
-    // Move assignment operator
-    TileBag& operator=(TileBag&& other);
+    // The seed of the last reseed and where the generator is now
+    std::uint64_t getSeed() const { return seed; }
+    std::uint64_t getRandomState() const { return random.getState(); }
+    void setRandomState(std::uint64_t seed, std::uint64_t state);
 
-    void shuffle(unsigned int randSeed);
-    Tile* drawTile();
-    void addTile(Tile* tile);
-    LinkedList* getTiles();
-    bool isEmpty() const;
-    
 private:
-    LinkedList tiles;
+    Tile tiles[MAX_BAG_TILES];
+    int head;
+    int length;
+    std::uint64_t draws;
+    std::uint64_t seed;
+    Random random;
 
-    // Debug function to print the number of tiles
-    void printTileCount() const;
-
-    // Function to clear all tiles from the bag
-    void clear();
-
-    std::vector<Tile*> seedTiles();
-    void Initialise(std::vector<Tile*>& tiles);
+    Tile& at(int index) { return tiles[(head + index) & (MAX_BAG_TILES - 1)]; }
 
+    std::vector<Tile> seedTiles();
+    void Initialise(std::vector<Tile>& tiles);
 };
 
+static_assert(std::is_trivially_copyable<TileBag>::value, "Tile bags are copied as plain bytes");
+
 #endif // ASSIGN2_TILEBAG_H
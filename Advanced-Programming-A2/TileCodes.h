@@ -11,6 +11,16 @@
 #define GREEN  'G'
 #define BLUE   'B'
 #define PURPLE 'P'
+#define CYAN   'C'
+#define WHITE  'W'
+
+// Colours in tile code order, a colour's code index is its position + 1.
+// A tile set with fewer colours uses the first ones.
+const char colourOrder[] = {RED, ORANGE, YELLOW, GREEN, BLUE, PURPLE, CYAN, WHITE};
+#define NUM_COLOURS 8
+
+// Tile code for an empty board cell
+#define EMPTY_TILE 0
 
 // Shapes
 #define CIRCLE    1
@@ -19,6 +29,9 @@
 #define SQUARE    4
 #define STAR_6    5
 #define CLOVER    6
+#define TRIANGLE  7
+#define HEART     8
+#define NUM_SHAPES 8
 
 const std::map<int, std::string> shapeMap = {
     {1, "\u25CF"},
@@ -26,7 +39,9 @@ const std::map<int, std::string> shapeMap = {
     {3, "\u25C6"},
     {4, "\u25A0"},
     {5, "\u2736"},
-    {6, "\u2724"}
+    {6, "\u2724"},
+    {7, "\u25B2"},
+    {8, "\u2665"}
 };
 const std::map<char, std::string> colourMap ={
     {'R', "91m"},
@@ -34,7 +49,9 @@ const std::map<char, std::string> colourMap ={
     {'Y', "93m"},
     {'G', "92m"},
     {'B', "94m"},
-    {'P', "95m"}
+    {'P', "95m"},
+    {'C', "96m"},
+    {'W', "97m"}
 };
 
 #endif // ASSIGN1_TILECODES_H
@@ -0,0 +1,55 @@
+#include "TileSet.h"
+#include <algorithm>
+#include <cmath>
+
+int TileSet::colours = STANDARD_COLOURS;
+int TileSet::shapes = STANDARD_SHAPES;
+int TileSet::copies = STANDARD_COPIES;
+TileMask TileSet::allTiles = 0x3F3F3F3F3F3Full;
+
+bool TileSet::configure(int colours, int shapes, int copies) {
+    if (colours < 1 || colours > MAX_COLOURS || shapes < 1 || shapes > MAX_SHAPES || copies < 1 || copies > MAX_COPIES) {
+        return false;
+    }
+    TileSet::colours = colours;
+    TileSet::shapes = shapes;
+    TileSet::copies = copies;
+
+    // One byte of the mask per colour, one bit of the byte per shape
+    TileMask shapeBits = (1ull << shapes) - 1;
+    allTiles = 0;
+    for (int colour = 0; colour < colours; ++colour) {
+        allTiles |= shapeBits << (colour * 8);
+    }
+    return true;
+}
+
+int TileSet::getColours() {
+    return colours;
+}
+
+int TileSet::getShapes() {
+    return shapes;
+}
+
+int TileSet::getCopies() {
+    return copies;
+}
+
+int TileSet::getTileCount() {
+    return colours * shapes * copies;
+}
+
+TileMask TileSet::getAllTiles() {
+    return allTiles;
+}
+
+bool TileSet::contains(Tile tile) {
+    return (allTiles & Tile::tileBit(tile.getCode())) != 0;
+}
+
+int TileSet::getBoardSize() {
+    const int standardTiles = STANDARD_COLOURS * STANDARD_SHAPES * STANDARD_COPIES;
+    double scale = std::sqrt((double)getTileCount() / standardTiles);
+    return std::max(STANDARD_BOARD_SIZE, (int)std::ceil(STANDARD_BOARD_SIZE * scale));
+}
@@ -0,0 +1,51 @@
+#ifndef ASSIGN2_TILESET_H
+#define ASSIGN2_TILESET_H
+
+#include "Tile.h"
+
+// Largest tile set a game can use, every tile still fits a TileMask and the bag
+#define MAX_COLOURS 8
+#define MAX_SHAPES 8
+#define MAX_COPIES 4
+
+// The standard game
+#define STANDARD_COLOURS 6
+#define STANDARD_SHAPES 6
+#define STANDARD_COPIES 2
+#define STANDARD_BOARD_SIZE 26
+
+/*
+ * The tiles the game is played with, the first colours in colourOrder, shapes
+ * 1 up to the number of shapes and the same number of copies of each. Chosen
+ * once before a game starts and read by the rules, bag and AI from then on.
+ */
+class TileSet {
+public:
+    // Play with a different tile set, false and unchanged if any count is out of range
+    static bool configure(int colours, int shapes, int copies);
+
+    static int getColours();
+    static int getShapes();
+    static int getCopies();
+
+    // Number of tiles in a full bag
+    static int getTileCount();
+
+    // Every tile in the set
+    static TileMask getAllTiles();
+
+    // Check if a tile belongs to the set
+    static bool contains(Tile tile);
+
+    // Side of a square board with room for the set, the standard 26 grown with the square root
+    // of the tile count so lines laid across the middle stay as far from the edge
+    static int getBoardSize();
+
+private:
+    static int colours;
+    static int shapes;
+    static int copies;
+    static TileMask allTiles;
+};
+
+#endif // ASSIGN2_TILESET_H
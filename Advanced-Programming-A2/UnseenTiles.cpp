@@ -0,0 +1,85 @@
+#include "UnseenTiles.h"
+#include "GameBoard.h"
+#include "Hand.h"
+#include "TileCodes.h"
+#include "TileSet.h"
+
+UnseenTiles::UnseenTiles() : counts(), total(0), mask(0) {
+    for (int colour = 0; colour < TileSet::getColours(); ++colour) {
+        for (int shape = 1; shape <= TileSet::getShapes(); ++shape) {
+            int index = Tile::tileIndex(Tile::encode(colourOrder[colour], shape));
+            counts[index] = TileSet::getCopies();
+            total += TileSet::getCopies();
+            mask |= 1ull << index;
+        }
+    }
+}
+
+UnseenTiles::UnseenTiles(const GameBoard& board, const Hand& hand) : UnseenTiles() {
+    // Only tile kinds in the full set can be seen, so walk those rather than the board
+    for (TileMask remaining = mask; remaining != 0; remaining &= remaining - 1) {
+        int index = __builtin_ctzll(remaining);
+        Tile tile = Tile::fromCode(Tile::indexCode(index));
+        int seen = board.getTileCount(tile) + hand.count(tile);
+        seen = seen < counts[index] ? seen : counts[index];
+        counts[index] -= seen;
+        total -= seen;
+        if (counts[index] == 0) {
+            mask &= ~(1ull << index);
+        }
+    }
+}
+
+void UnseenTiles::see(Tile tile) {
+    int index = Tile::tileIndex(tile.getCode());
+    if (index < 0 || counts[index] == 0) {
+        return;
+    }
+    total--;
+    if (--counts[index] == 0) {
+        mask &= ~(1ull << index);
+    }
+}
+
+void UnseenTiles::unsee(Tile tile) {
+    int index = Tile::tileIndex(tile.getCode());
+    if (index < 0) {
+        return;
+    }
+    total++;
+    counts[index]++;
+    mask |= 1ull << index;
+}
+
+double UnseenTiles::probability(Tile tile) const {
+    return total == 0 ? 0 : (double)count(tile) / total;
+}
+
+double UnseenTiles::probability(TileMask tiles) const {
+    return total == 0 ? 0 : (double)countAll(tiles) / total;
+}
+
+double UnseenTiles::probabilityWithin(TileMask tiles, int draws) const {
+    // One minus the chance every draw misses the set, drawing without replacement
+    int misses = total - countAll(tiles);
+    double allMiss = 1;
+    for (int i = 0; i < draws && allMiss > 0; ++i) {
+        if (total - i <= 0) {
+            break;
+        }
+        allMiss *= (double)(misses - i > 0 ? misses - i : 0) / (total - i);
+    }
+    return total == 0 ? 0 : 1 - allMiss;
+}
+
+double UnseenTiles::probabilityFits(const GameBoard& board, int row, int col) const {
+    return probability(board.getLegalTiles(row, col));
+}
+
+int UnseenTiles::countAll(TileMask tiles) const {
+    int sum = 0;
+    for (TileMask remaining = tiles & mask; remaining != 0; remaining &= remaining - 1) {
+        sum += counts[__builtin_ctzll(remaining)];
+    }
+    return sum;
+}
@@ -0,0 +1,57 @@
+#ifndef ASSIGN2_UNSEENTILES_H
+#define ASSIGN2_UNSEENTILES_H
+
+#include <type_traits>
+#include "Tile.h"
+
+class GameBoard;
+class Hand;
+
+/*
+ * The tiles one player can not see, those in the bag and in the opponent's
+ * hand, counted per tile. Built from the board's and hand's own count tables,
+ * then kept up to date one tile at a time while a search plays moves out.
+ */
+class UnseenTiles {
+public:
+    // Every tile of a full tile set
+    UnseenTiles();
+
+    // What a player holding hand can not see with board in play
+    UnseenTiles(const GameBoard& board, const Hand& hand);
+
+    // A copy of a tile came into view, drawn into the hand or placed by the opponent
+    void see(Tile tile);
+    // A copy of a tile went back out of view into the bag
+    void unsee(Tile tile);
+
+    int count(Tile tile) const {
+        int index = Tile::tileIndex(tile.getCode());
+        return index < 0 ? 0 : counts[index];
+    }
+    int getTotal() const { return total; }
+    // Every tile with at least one unseen copy
+    TileMask getMask() const { return mask; }
+
+    // Chance the next draw is a tile, or any of a set of tiles
+    double probability(Tile tile) const;
+    double probability(TileMask tiles) const;
+
+    // Chance at least one of several draws is in a set of tiles
+    double probabilityWithin(TileMask tiles, int draws) const;
+
+    // Chance the next draw could be placed in a cell, such as the one that completes a line
+    double probabilityFits(const GameBoard& board, int row, int col) const;
+
+private:
+    unsigned char counts[TILE_MASK_BITS];
+    int total;
+    TileMask mask;
+
+    // Unseen copies of the tiles in a set
+    int countAll(TileMask tiles) const;
+};
+
+static_assert(std::is_trivially_copyable<UnseenTiles>::value, "Unseen tile tables are copied as plain bytes");
+
+#endif // ASSIGN2_UNSEENTILES_H
@@ -4,6 +4,8 @@
 #include <sstream>
 #include <random>
 #include <set>
+#include <algorithm>
+#include <cctype>
 #include "Tile.h"
 #include "TileBag.h"
 #include "Player.h"
@@ -17,13 +19,22 @@
 #include "Rules.h"
 #include "Tests.cpp"
 #include "Ai.h"
+#include "SelfPlay.h"
+#include "MoveGenerator.h"
+#include "TileCodes.h"
+#include "TileSet.h"
+#include "MoveJournal.h"
+#include "SaveWriter.h"
+#include "ReplayEngine.h"
 
 typedef std::set<std::string> Flags;
 
 #define EXIT_SUCCESS 0
-#define NUM_BOARD_ROWS 26
-#define NUM_BOARD_COLS 26
+// Rows are named by a single letter, so a board can have no more
+#define MAX_BOARD_ROWS 26
 #define STARTING_HAND_SIZE 6
+// Column numbers are typed with at most this many digits, more can not be on the board
+#define MAX_COLUMN_DIGITS 3
 
 // Function prototypes
 void displayWelcomeMessage();
@@ -32,10 +43,17 @@ void startNewGame(bool &quit, Flags flags);
 void loadGame(bool &quit, Flags flags);
 void showCredits();
 void handleMenuChoice(int choice, bool &quit, Flags flags);
-void playTurn(Player *player, Player *opponent, TileBag *tileBag, GameBoard *board, bool &quit, Flags flags);
+void playTurn(Player *player, Player *opponent, TileBag *tileBag, GameBoard *board, bool &quit, Flags flags, MoveJournal *journal, SaveWriter *saveWriter);
+void reportSaves(SaveWriter *saveWriter, Flags flags);
+int replayGame(const std::string &filename, Flags flags);
+bool isMultiTileMove(const std::vector<std::string> &moveBreakdown);
+bool parseCell(const std::string &cell, int &row, int &col);
+bool playMultiTileMove(Player *player, TileBag *tileBag, GameBoard *gameBoard, const std::vector<std::string> &moveBreakdown, Move &move);
 void gameLoop(Player *player1, Player *player2, TileBag *tileBag, GameBoard *board, Flags flags);
 void printScores(Player *player1, Player *player2, TileBag *tileBag, GameBoard* GameBoard, bool &quit);
 std::string handleInput(bool &quit);
+bool flagValue(const Flags &flags, const std::string &name, int &value);
+bool flagText(const Flags &flags, const std::string &name, std::string &value);
 
 int main(int argc, char **argv)
 {
@@ -46,13 +64,47 @@ int main(int argc, char **argv)
   for (int i = 1; i < argc; i++) {
     flags.insert(std::string(argv[i]));
   }
-  
+
+  // --ai-threads=N shares the AI player's move search between N threads
+  int aiThreads;
+  if (flagValue(flags, "--ai-threads=", aiThreads)) {
+    Ai::setWorkers(aiThreads);
+  }
+  // --ai-time-ms=N lets the AI player search deeper for up to N milliseconds a turn
+  int aiTimeMs;
+  if (flagValue(flags, "--ai-time-ms=", aiTimeMs)) {
+    Ai::setTimeBudget(aiTimeMs);
+  }
+  // --colours=N, --shapes=N and --copies=N play with a larger or smaller tile set
+  int colours = TileSet::getColours();
+  int shapes = TileSet::getShapes();
+  int copies = TileSet::getCopies();
+  flagValue(flags, "--colours=", colours);
+  flagValue(flags, "--shapes=", shapes);
+  flagValue(flags, "--copies=", copies);
+  if (!TileSet::configure(colours, shapes, copies)) {
+    std::cerr << "Tile sets have 1 to " << MAX_COLOURS << " colours, 1 to " << MAX_SHAPES << " shapes and 1 to "
+              << MAX_COPIES << " copies of each tile." << std::endl;
+    return 1;
+  }
+
   if (flags.count("test") > 0) {
     // run unit tetsts
     Tests::run();
     return EXIT_SUCCESS;
   }
 
+  if (flags.count("selfplay") > 0) {
+    // play AI against AI without the interactive game
+    return SelfPlay::run(argc, argv);
+  }
+
+  // --replay=FILE steps through a saved game and the turns journalled after it
+  std::string replayFile;
+  if (flagText(flags, "--replay=", replayFile)) {
+    return replayGame(replayFile, flags);
+  }
+
   displayWelcomeMessage();
 
   while (!quit)
@@ -134,7 +186,7 @@ void startNewGame(bool &quit, Flags flags)
   Player player1(player1Name);
   Player player2(player2Name);
   
-  GameBoard gameBoard(NUM_BOARD_ROWS, NUM_BOARD_COLS);
+  GameBoard gameBoard(std::min(MAX_BOARD_ROWS, TileSet::getBoardSize()), TileSet::getBoardSize());
   gameBoard.setEnhancedMode(enhancedMode);
 
   TileBag tileBag;
@@ -205,7 +257,7 @@ void loadGame(bool& quit, Flags flags) {
     delete currentPlayer;
 }
 
-void playTurn(Player *player, Player *opponent, TileBag *tileBag, GameBoard* gameBoard, bool &quit, Flags flags)
+void playTurn(Player *player, Player *opponent, TileBag *tileBag, GameBoard* gameBoard, bool &quit, Flags flags, MoveJournal *journal, SaveWriter *saveWriter)
 {
   bool aiMode = flags.count("--ai") > 0;
   bool enhancedMode = flags.count("--e") > 0;
@@ -231,9 +283,17 @@ void playTurn(Player *player, Player *opponent, TileBag *tileBag, GameBoard* gam
       std::cout << "Enter filename to save: ";
       std::string filename = handleInput(quit);
       
-      FileHandler fileHandler;
-      fileHandler.saveGame(filename, player, opponent, tileBag, gameBoard, player, aiMode);
+      // The file is written in the background, but the player waits to hear it has been saved
+      saveWriter->submit(SaveSnapshot(filename, player, opponent, tileBag, gameBoard, player, aiMode));
+      saveWriter->wait();
+      reportSaves(saveWriter, flags);
       std::cout << "Game saved to " << filename << std::endl;
+      // Saving over the journalled file makes the turns so far part of the save
+      if (journal->isFor(filename))
+      {
+        journal->start(filename, player, opponent);
+        journal->beginTurn(tileBag, gameBoard);
+      }
     }
     else if (playerMove.substr(0, 7) == "replace")
     {
@@ -243,18 +303,16 @@ void playTurn(Player *player, Player *opponent, TileBag *tileBag, GameBoard* gam
       {
         char colour = tileToReplace[0];
         int shape = tileToReplace[1] - '0';
-        Tile *tile = new Tile(colour, shape);
-        Tile *removedTile = player->removeTileFromHand(tile);
-        if (removedTile != nullptr)
+        Tile tile(colour, shape);
+        if (player->removeTileFromHand(tile))
         {
-          std::cout << removedTile->print() << " tile removed from hand and added to the bag." << std::endl;
-          delete removedTile;
+          std::cout << tile.print() << " tile removed from hand and added to the bag." << std::endl;
           tileBag->addTile(tile);
-          Tile *newTile = tileBag->drawTile();
-          if (newTile != nullptr)
+          Tile newTile = tileBag->drawTile();
+          if (!newTile.isEmpty())
           {
             player->addTileToHand(newTile);
-            std::cout << newTile->print() << " tile drawn and added to your hand." << std::endl;
+            std::cout << newTile.print() << " tile drawn and added to your hand." << std::endl;
           }
           else
           {
@@ -283,16 +341,15 @@ void playTurn(Player *player, Player *opponent, TileBag *tileBag, GameBoard* gam
         moveBreakdown.push_back(extractedWord);
       }
 
-      if (moveBreakdown.size() == 4 && moveBreakdown[0] == "place" && moveBreakdown[2] == "at")
+      int row = 0;
+      int col = 0;
+      if (moveBreakdown.size() == 4 && moveBreakdown[0] == "place" && moveBreakdown[2] == "at" &&
+          parseCell(moveBreakdown[3], row, col))
       {
         char tileColour = moveBreakdown[1][0];
         int tileShape = moveBreakdown[1][1] - '0';
-        char rowChar = moveBreakdown[3][0];
-        int col = std::stoi(moveBreakdown[3].substr(1));
-
-        int row = rowChar - 'A';
 
-        Tile* tile = new Tile(tileColour, tileShape);
+        Tile tile(tileColour, tileShape);
 
         // Checks if the tile exists in the player's hand
         if (player->containsTile(tile)) 
@@ -300,18 +357,14 @@ void playTurn(Player *player, Player *opponent, TileBag *tileBag, GameBoard* gam
           if (Rules::validateMove(gameBoard, tile, row, col))
           {
             gameBoard->placeTile(row, col, tile);
-            Tile* removedTile = player->removeTileFromHand(tile);
-            if (removedTile != nullptr)
+            Move move = {{{row, col, tile.getCode()}}, 1, 0};
+            journal->recordMove(move);
+            if (player->removeTileFromHand(tile))
             {
-              delete removedTile;
-              Tile* newTile = tileBag->drawTile();
-              if (newTile != nullptr)
-              {
-                player->addTileToHand(newTile);
-              }
+              player->drawQuantityTiles(tileBag, 1);
               int score = Rules::calculateScore(gameBoard, row, col);
               player->setScore(player->getScore() + score);
-              if (score > 6)
+              if (Rules::isQwirkle(gameBoard->getRowRun(row, col)) || Rules::isQwirkle(gameBoard->getColumnRun(row, col)))
               {
                 std::cout << "QWIRKLE!!!" << std::endl;
               }
@@ -325,13 +378,20 @@ void playTurn(Player *player, Player *opponent, TileBag *tileBag, GameBoard* gam
           else
           {
             std::cout << "Invalid move. Try again." << std::endl;
-            delete tile;
           }
         } 
         else 
         {
           std::cout << "You don't have that tile in your hand." << std::endl;
-          delete tile;
+        }
+      }
+      else if (isMultiTileMove(moveBreakdown))
+      {
+        Move move;
+        validInput = playMultiTileMove(player, tileBag, gameBoard, moveBreakdown, move);
+        if (validInput)
+        {
+          journal->recordMove(move);
         }
       }
       else
@@ -342,23 +402,176 @@ void playTurn(Player *player, Player *opponent, TileBag *tileBag, GameBoard* gam
   }
 }
 
+// Check for a move of the form "place <tile> at <position> and <tile> at <position> ..."
+bool isMultiTileMove(const std::vector<std::string> &moveBreakdown)
+{
+  int words = moveBreakdown.size();
+  if (words < 8 || words % 4 != 0 || words / 4 > MAX_MOVE_TILES || moveBreakdown[0] != "place")
+  {
+    return false;
+  }
+  int row = 0;
+  int col = 0;
+  for (int i = 0; i < words; i += 4)
+  {
+    if ((i > 0 && moveBreakdown[i] != "and") || moveBreakdown[i + 1].size() != 2 || moveBreakdown[i + 2] != "at" ||
+        !parseCell(moveBreakdown[i + 3], row, col))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Read a cell such as "B12", false unless it is a letter followed by 1 to MAX_COLUMN_DIGITS digits
+bool parseCell(const std::string &cell, int &row, int &col)
+{
+  if (cell.size() < 2 || cell.size() > 1 + MAX_COLUMN_DIGITS)
+  {
+    return false;
+  }
+  for (size_t i = 1; i < cell.size(); ++i)
+  {
+    if (!isdigit(static_cast<unsigned char>(cell[i])))
+    {
+      return false;
+    }
+  }
+  row = cell[0] - 'A';
+  col = std::stoi(cell.substr(1));
+  return true;
+}
+
+bool playMultiTileMove(Player *player, TileBag *tileBag, GameBoard *gameBoard, const std::vector<std::string> &moveBreakdown, Move &move)
+{
+  move.count = 0;
+  for (size_t i = 0; i < moveBreakdown.size(); i += 4)
+  {
+    Tile tile(moveBreakdown[i + 1][0], moveBreakdown[i + 1][1] - '0');
+    int row = 0;
+    int col = 0;
+    parseCell(moveBreakdown[i + 3], row, col);
+    move.placements[move.count++] = {row, col, tile.getCode()};
+  }
+
+  // Every tile has to be in the hand, a tile named twice has to be held twice
+  Hand hand = *player->getHand();
+  for (int i = 0; i < move.count; ++i)
+  {
+    if (!hand.remove(Tile::fromCode(move.placements[i].tile)))
+    {
+      std::cout << "You don't have that tile in your hand." << std::endl;
+      return false;
+    }
+  }
+
+  int score = MoveGenerator::scoreMove(*gameBoard, move);
+  if (score < 0)
+  {
+    std::cout << "Invalid move. Try again." << std::endl;
+    return false;
+  }
+
+  MoveGenerator::applyMove(gameBoard, move);
+  bool qwirkle = false;
+  for (int i = 0; i < move.count; ++i)
+  {
+    const Placement &placement = move.placements[i];
+    player->removeTileFromHand(Tile::fromCode(placement.tile));
+    qwirkle = qwirkle || Rules::isQwirkle(gameBoard->getRowRun(placement.row, placement.col)) ||
+              Rules::isQwirkle(gameBoard->getColumnRun(placement.row, placement.col));
+  }
+  player->drawQuantityTiles(tileBag, move.count);
+  player->setScore(player->getScore() + score);
+  if (qwirkle)
+  {
+    std::cout << "QWIRKLE!!!" << std::endl;
+  }
+  return true;
+}
+
 
 void gameLoop(Player *player1, Player *player2, TileBag *tileBag, GameBoard* gameBoard, Flags flags)
 {
   bool aiMode = flags.count("--ai") > 0;
   bool quit = false;
+
+  // --journal=FILE saves the game to FILE and then records every turn beside it,
+  // so loading FILE after the game stops early carries on from the last turn
+  MoveJournal journal;
+  std::string journalFile;
+  FileHandler fileHandler;
+  // --autosave=FILE saves the whole game to FILE after every turn, on a background thread
+  SaveWriter saveWriter;
+  std::string autosaveFile;
+  bool autosave = flagText(flags, "--autosave=", autosaveFile);
+  if (flagText(flags, "--journal=", journalFile))
+  {
+    fileHandler.saveGame(journalFile, player1, player2, tileBag, gameBoard, player1, aiMode);
+    if (!journal.start(journalFile, player1, player2))
+    {
+      std::cerr << "Error: Unable to start a journal for " << journalFile << std::endl;
+    }
+  }
+
   while (!quit)
   {
     printScores(player1, player2, tileBag, gameBoard, quit);
-    playTurn(player1, player2, tileBag, gameBoard, quit, flags);
+    journal.beginTurn(tileBag, gameBoard);
+    playTurn(player1, player2, tileBag, gameBoard, quit, flags, &journal, &saveWriter);
+    if (!quit && !journal.endTurn(player1, tileBag, gameBoard))
+    {
+      fileHandler.saveGame(journalFile, player2, player1, tileBag, gameBoard, player2, aiMode);
+      journal.start(journalFile, player2, player1);
+    }
+    if (!quit && autosave)
+    {
+      saveWriter.submit(SaveSnapshot(autosaveFile, player2, player1, tileBag, gameBoard, player2, aiMode));
+    }
+    reportSaves(&saveWriter, flags);
     if (!quit)
     {
       printScores(player1, player2, tileBag, gameBoard, quit);
+      journal.beginTurn(tileBag, gameBoard);
       if (aiMode) {
-        Ai::playTurn(player2, tileBag, gameBoard);
+        Move move;
+        if (Ai::playTurn(player2, tileBag, gameBoard, move)) {
+          journal.recordMove(move);
+        }
       } else {
-        playTurn(player2, player1, tileBag, gameBoard, quit, flags);
+        playTurn(player2, player1, tileBag, gameBoard, quit, flags, &journal, &saveWriter);
+      }
+      if (!quit && !journal.endTurn(player2, tileBag, gameBoard))
+      {
+        fileHandler.saveGame(journalFile, player1, player2, tileBag, gameBoard, player1, aiMode);
+        journal.start(journalFile, player1, player2);
+      }
+      if (!quit && autosave)
+      {
+        saveWriter.submit(SaveSnapshot(autosaveFile, player1, player2, tileBag, gameBoard, player1, aiMode));
       }
+      reportSaves(&saveWriter, flags);
+    }
+  }
+  saveWriter.wait();
+  reportSaves(&saveWriter, flags);
+}
+
+// Print how the background saves that have finished went, autosaves are only mentioned if they fail
+void reportSaves(SaveWriter *saveWriter, Flags flags)
+{
+  std::string autosaveFile;
+  flagText(flags, "--autosave=", autosaveFile);
+  SaveResult result;
+  while (saveWriter->takeResult(result))
+  {
+    if (!result.saved)
+    {
+      std::cerr << "Error: " << result.filename << ": " << result.error << std::endl;
+    }
+    else if (result.filename != autosaveFile)
+    {
+      std::cout << "Game successfully saved" << std::endl;
     }
   }
 }
@@ -398,7 +611,7 @@ void handleMenuChoice(int choice, bool &quit, Flags flags)
 }
 
 void printScores(Player* player1, Player* player2, TileBag *tileBag, GameBoard *gameBoard, bool &quit) {
-    if (Rules::isGameOver(player1, player2, tileBag))
+    if (Rules::isGameOver(player1, player2, tileBag, gameBoard))
     {
       std::cout << gameBoard->displayBoard() << std::endl;
       Player* winner = player1->getScore() > player2->getScore() ? player1 : player2;
@@ -425,4 +638,97 @@ std::string handleInput(bool &quit)
     quit = true;
   }
   return input;
-}
\ No newline at end of file
+}
+
+// Step through a recorded game, going to any move at once. --keyframe=N sets how many moves apart the keyframes are.
+int replayGame(const std::string &filename, Flags flags)
+{
+  int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL;
+  flagValue(flags, "--keyframe=", keyframeInterval);
+  ReplayEngine replay(keyframeInterval);
+  if (!replay.load(filename))
+  {
+    std::cerr << "Error: Unable to replay " << filename << std::endl;
+    return 1;
+  }
+  std::cout << "Replaying " << replay.getName(0) << " against " << replay.getName(1) << ", "
+            << replay.getMoveCount() << " moves" << std::endl;
+  replay.seek(0);
+
+  GameBoard board(replay.getRows(), replay.getCols());
+  bool quit = false;
+  while (!quit)
+  {
+    replay.copyBoard(board);
+    std::cout << board.displayBoard() << std::endl;
+    for (int player = 0; player < 2; ++player)
+    {
+      std::cout << "Score for " << replay.getName(player) << ": " << replay.getScore(player)
+                << ", tiles in hand: " << replay.getHand(player).toString() << std::endl;
+    }
+    std::cout << "Move " << replay.getMove() << " of " << replay.getMoveCount() << ", "
+              << replay.getName(replay.getPlayerToMove()) << " to play" << std::endl;
+    std::cout << "Go to move (a number, next, back or quit): ";
+    std::string input = handleInput(quit);
+
+    if (input == "quit" || quit)
+    {
+      quit = true;
+    }
+    else if (input.empty() || input == "next")
+    {
+      replay.step();
+    }
+    else if (input == "back")
+    {
+      replay.seek(replay.getMove() - 1);
+    }
+    else
+    {
+      try
+      {
+        replay.seek(std::stoi(input));
+      }
+      catch (const std::exception &)
+      {
+        std::cout << "Invalid input. Enter a move number from 0 to " << replay.getMoveCount() << "." << std::endl;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// Read the number from a flag of the form <name><number>, false if the flag is missing or invalid
+bool flagValue(const Flags &flags, const std::string &name, int &value)
+{
+  for (const std::string &flag : flags)
+  {
+    if (flag.compare(0, name.size(), name) == 0)
+    {
+      try
+      {
+        value = std::stoi(flag.substr(name.size()));
+        return true;
+      }
+      catch (const std::exception &)
+      {
+        std::cout << "Invalid value for " << name.substr(0, name.size() - 1) << ", using the default." << std::endl;
+      }
+    }
+  }
+  return false;
+}
+
+// Read the text from a flag of the form <name><text>, false if the flag is missing or empty
+bool flagText(const Flags &flags, const std::string &name, std::string &value)
+{
+  for (const std::string &flag : flags)
+  {
+    if (flag.compare(0, name.size(), name) == 0 && flag.size() > name.size())
+    {
+      value = flag.substr(name.size());
+      return true;
+    }
+  }
+  return false;
+}